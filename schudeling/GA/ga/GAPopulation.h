@@ -38,11 +38,22 @@ then you cannot use the 'size' method to make the population bigger.  When
 resizing to a larger size, we clone randomly individuals from the existing
 population.
 
+reserve
+  Make room for s genome pointers without creating any genomes.  A GA that
+adds genomes to the population before it removes others (the steady-state
+GA adds its whole temporary population every generation) reserves the room
+once, so that add never has to reallocate the arrays during the run.
+
 sort
   The sort member is defined so that it can work on a const population.  It
 does not change the logical state of the population, but it does change its
 physical state.  We sort from best (0th individual) to worst (n-1).  The sort
 figures out whether high is best or low is best.
+  The sort is incremental: the part of the array that is still in order from
+the front (a sorted population with new genomes added at the end, or the boa
+with its worst genome replaced) is kept, only the rest is quicksorted, and the
+two runs are merged.  With k genomes out of place a sort costs n + k log k
+instead of n log n.
 
 evaluate
   If you want to force an evaluation, pass gaTrue to the evaluate member
@@ -91,6 +102,7 @@ public:
   int size(unsigned int popsize);
   int chunksize() const { return csz; }
   int chunksize(unsigned int csize) { return csz=csize; }
+  int reserve(unsigned int s) { return grow(s); }
   int compact();
 
   void touch() 
@@ -197,6 +209,8 @@ protected:
   float* indDiv;		// table for genome similarities (diversity)
   GAGenome** rind;		// the individuals of the population (raw)
   GAGenome** sind;		// the individuals of the population (scaled)
+  GAGenome** tind;		// scratch for merging sorted runs (sort)
+  unsigned int tN;		// how many fit in tind
   float fitSum, fitAve;		// sum, ave of the population's fitness scores
   float fitMax, fitMin;		// max, min of the population's fitness scores
   float fitVar, fitDev;		// variance, standard deviation of fitness
@@ -209,6 +223,7 @@ protected:
   GAEvalData* evaldata;		// data for evaluator to use (optional)
 
   int grow(unsigned int);
+  void mergesort(GAGenome**, SortBasis) const;
 
   static void QuickSortAscendingRaw(GAGenome**, int, int);
   static void QuickSortDescendingRaw(GAGenome**, int, int);
@@ -119,6 +119,9 @@ incorporate it into the code base.
   GALIB_USE_RAND      the same way on each platform).  For best results, use
   GALIB_USE_RANDOM    ran2 or ran3 (performance is slightly slower than most
   GALIB_USE_RAND48    system RNGs, but you'll get better results).
+  GALIB_USE_XOSHIRO   xoshiro256** (the default): faster than ran2, with a
+                      period of 2^256-1, and each thread gets its own stream
+                      from GARandomSeedStream (see random.h).
 
                       If you want to use another random number generator you
                       must hack random.h directly (see the comments in that
@@ -473,13 +476,27 @@ incorporate it into the code base.
 #endif
 
 
-// If no RNG has been selected, use the ran2 generator by default
+// If no RNG has been selected, use the xoshiro256** generator by default
 #if !defined(GALIB_USE_RAND) && \
     !defined(GALIB_USE_RANDOM) && \
     !defined(GALIB_USE_RAND48) && \
+    !defined(GALIB_USE_RAN1) && \
     !defined(GALIB_USE_RAN2) && \
-    !defined(GALIB_USE_RAN3)
-#define GALIB_USE_RAN2
+    !defined(GALIB_USE_RAN3) && \
+    !defined(GALIB_USE_XOSHIRO)
+#define GALIB_USE_XOSHIRO
+#endif
+
+
+// Storage class of the random number generator state.  With a C++11 compiler
+// every thread has its own generator (seed it with GARandomSeed from inside
+// the thread), so that several GAs or demes can evolve on different threads.
+#if !defined(GALIB_THREAD_LOCAL)
+#if __cplusplus >= 201103L
+#define GALIB_THREAD_LOCAL thread_local
+#else
+#define GALIB_THREAD_LOCAL
+#endif
 #endif
 
 
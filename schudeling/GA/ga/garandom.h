@@ -40,6 +40,13 @@ GAUnitGaussian
 GAGaussianFloat, GAGaussianDouble
   Scaled versions of the gaussian distribution.  You must specify a stddev, 
 then these functions scale the distribution to that deviation.  Mean is still 0
+
+GARandomSeedStream
+  Seed the generator of the calling thread with stream number 'stream' of the
+master seed.  The state is derived from both numbers with splitmix64, so every
+(master, stream) pair gives an independent, reproducible sequence: use one
+stream per thread, island or run and the results do not depend on which thread
+ran what or when.  Unlike GARandomSeed this always resets the generator.
 ---------------------------------------------------------------------------- */
 #ifndef _ga_random_h_
 #define _ga_random_h_
@@ -64,9 +71,17 @@ then these functions scale the distribution to that deviation.  Mean is still 0
 // genetic algorithms the random number generator is the bottleneck, so this
 // isn't totally useless musing...
 
-#if defined(GALIB_USE_RAN1) || defined(GALIB_USE_RAN2) || defined(GALIB_USE_RAN3)
+#if defined(GALIB_USE_RAN1) || defined(GALIB_USE_RAN2) || \
+    defined(GALIB_USE_RAN3) || defined(GALIB_USE_XOSHIRO)
+
+#if defined(GALIB_USE_XOSHIRO)
+
+#define _GA_RND             garanxs
+#define _GA_RND_SEED        gasranxs
+void gasranxs(unsigned int seed=1);
+float garanxs();
 
-#if defined(GALIB_USE_RAN1)
+#elif defined(GALIB_USE_RAN1)
 
 #define _GA_RND             garan1
 #define _GA_RND_SEED        gasran1
@@ -164,6 +179,7 @@ inline float GARandomFloat(float low, float high){
 unsigned int GAGetRandomSeed();
 void GARandomSeed(unsigned int seed=0);
 void GAResetRNG(unsigned int seed);
+void GARandomSeedStream(unsigned int master, unsigned int stream);
 int GARandomBit();
 double GAUnitGaussian();
 
@@ -28,6 +28,11 @@ typedef enum _GAStatus {
 // smallest type available on your platform.  
 typedef unsigned char GABit;
 
+// The binary strings pack their bits into words of this type, bit i of the
+// string being bit i%GA_BITWORD_SIZE of word i/GA_BITWORD_SIZE.
+typedef unsigned long long GABitWord;
+#define GA_BITWORD_SIZE 64
+
 
 #define GAMax(a,b) ((a) > (b) ? (a) : (b))
 #define GAMin(a,b) ((a) < (b) ? (a) : (b))
@@ -25,11 +25,18 @@
 
 //Includes
 #include "scheduling_fact.h"
+#include "Scheduling_kernels.h"
+#include "Scheduling_simd.h"
+#include "Scheduling_pool.h"
+#include "Scheduling_deme.h"
 #include <time.h>
+#include <chrono>
+#include <cmath>
 #include <sstream>
 #include <algorithm>
 #include <queue>
 #include <set>
+#include <new>
 #include <ga.h>
 #include <ga/GASimpleGA.h>  // we're going to use the simple GA
 #include <ga/GA2DBinStrGenome.h> // and the 2D binary string genome
@@ -59,35 +66,54 @@
 // #define cout STD_COUT     // optional
 // #define ostream STD_OSTREAM      // optional
 
+// Dimensoes da instancia em execucao (definidas em SetProblema)
+#define MACHINE     (instancia.iMachines)
+#define JOB         (instancia.iJobs)
+#define ITER        (instancia.iIter)
+
+// Lotes de candidatas com menos operacoes que isso (candidatas x MACHINE*JOB)
+// sao avaliados na propria thread: dividir entre as threads do pool nao paga
+// a sincronizacao
+#define LOTEMINIMOPOOL  8192
+
+// Movimentos lembrados pela busca tabu (ver tabuSearch())
+#define TABUTENURE      8
+
+// Insercoes de cada maquina avaliadas de fato, as de menor estimativa (ver
+// insercao())
+#define INSERCAOEXATOS  8
+
+// Operadores de busca local de Objective(), um por semente (ver
+// escolheOperador()): cada chamada anterior pesa OPERADORDESCONTO vezes
+// menos a cada nova chamada (janela de ~100 chamadas)
+#define NOPERADORES         3
+#define OPERADORDESCONTO    0.99
+#define OPERADOREXPLORACAO  0.5
+
 using namespace std;
 
 //============METODOS DE BUSCA LOCAL - PERMUTAO/INSERO============
 //A avaliao  refeita a cada movimentao no cromossomo
 void insercao(vector<int> vet, int originalScore);
 void permutacao(vector<int> vet, int originalScore);
-void entrarInsercao(vector<int> vet, int originalScore);
 void insercaoCompleta(vector<int> vet, int originalScore);
 void mostraResultadoFinais(size_t opcao, size_t scoreFinal);
-//--Define a janela da insercao - Parametros passados para o  problema L01--
-//Indice final tem que ser maior que o indice inicio.
-int startWindow = 3;
-int finalWindow = 6;
-//---------------------------------------------------------------------------
+void mostraMelhoria(int score);
 
 // listaSolucaoPermutacao:  armazena a melhor soluo encontrada na funo permutao.
 // bestScorePermutacao: Guarda o melhor score encontrado na funo permutao
-vector <int> listaSolucaoPermutacao;
-int bestScorePermutacao;
+thread_local vector <int> listaSolucaoPermutacao;
+thread_local int bestScorePermutacao;
 
 //listaSolucaoInsercao:  armazena a melhor soluo encontrada na funo insercao.
 //bestScoreInsercao: Guarda o melhor score encontrado na funo insercao
-vector <int> listaSolucaoInsercao;
-int bestScoreInsercao;
+thread_local vector <int> listaSolucaoInsercao;
+thread_local int bestScoreInsercao;
 vector<int> bestSeedBuscaLocal;
 vector<int> seedFinal;
 
-vector <int> listaSolucaoInsercaoCompleta;
-int bestScoreInsercaoCompleta;
+thread_local vector <int> listaSolucaoInsercaoCompleta;
+thread_local int bestScoreInsercaoCompleta;
 
 //==================FINAL METODOS DE BUSCA LOCAL - PERMUTAO/INSERO====================================
 
@@ -102,24 +128,117 @@ int * gera_sequencia();
 void setup();
 void localSearch();
 void localSearch(const GAStatistics &);
+void tabuSearch(const GAStatistics &);
+void vizinhancaN5(const vector<int> &pSemente, const vector<int> &pBloco, const vector<int> &pCabecas,
+                  const vector<int> &pCaudas, vector<int> &pMovimentos);
 int SetProblema(int intProblema);
+void DimensionaInstancia(int intProblema, int intMaquinas, int intJobs);
+int executaProblema();
+void reiniciaEstado();
 //int LocalSearch4 implementado
 int localSearch4(GAGenome& g, int originalScore);
 void cpBasedSeedGA();
-void findCriticalPath(vector<int> s);
+int findCriticalPath(const vector<int> &s);
 void  changeSeed(const GAStatistics &);
 //void changeSeed(const GAStatistics &);
 string desktopFolder ();
 string ProximoArquivo( string pNomeArq, string pExtArq );
 
 int projectDuration(vector<int> S);
+int avaliaSemente(const vector<int> &pSemente);
+int avaliaSementeLimite(const vector<int> &pSemente, int intLimite);
+int estimaTroca(const vector<int> &pSemente, int intPos);
+void indexaSemente(const vector<int> &pSemente, vector<int> &pPosicoes);
+void trocaSemente(vector<int> &pSemente, vector<int> &pPosicoes, int intPos1, int intPos2);
+void listaTrocasGenoma(const GA2DBinaryStringGenome &pGenoma, vector<int> &pTrocas);
+void applyGenomeToSeed(vector<int> &pSemente, const vector<int> &pTrocas);
+void applyGenomeToSeed(vector<int> &pSemente, const GA2DBinaryStringGenome &pGenoma);
+void indexaCaminhoCritico(const vector<int> &pPosicoes, vector<int> &pMaquinas, vector<int> &pPosCaminho);
+int marcaBlocosCriticos(const vector<int> &pSemente, vector<int> &pBloco, vector<char> &pExtremo,
+                        vector<int> &pCabecas, vector<int> &pCaudas);
+int estimaInsercao(const vector<int> &pSemente, const vector<int> &pCabecas, const vector<int> &pCaudas,
+                   int intDe, int intPara);
+
+// Lote de sementes candidatas para evaluateBatch(). O elemento i da
+// candidata c fica em vetSementes[i*intCapacidade + c] (structure-of-arrays).
+struct LoteSementes {
+    vector<int> vetSementes;
+    vector<int> vetMakespans;
+    int intCapacidade;
+    int intQuantidade;
+};
+void loteLimpa(LoteSementes &pLote);
+void loteAdiciona(LoteSementes &pLote, const vector<int> &pSemente);
+int loteAvalia(LoteSementes &pLote, int intLimite);
+void loteSemente(const LoteSementes &pLote, int intCandidata, vector<int> &pSemente);
+
+// Desempenho de um operador de busca local de Objective(). Os valores
+// descontados guiam escolheOperador(); os totais vao para o arquivo de
+// resultados. O custo e contado em sementes avaliadas (consultas ao
+// avaliador), que nao dependem da maquina: com -s a execucao se repete.
+struct EstatisticaOperador {
+    double dblGanho;            // descontados: makespan ganho,
+    double dblAvaliacoes;       // sementes avaliadas
+    double dblChamadas;         // e chamadas
+    long lngChamadas;           // totais
+    long lngMelhorias;
+    long lngGanho;
+    long lngAvaliacoes;
+    double dblMilissegundos;
+};
+void registraOperador(int intOperador, int intGanho, long lngAvaliacoes, double dblMilissegundos);
+int escolheOperador();
+void executaOperador(int intOperador, const vector<int> &pSemente, int intScore);
+void mesclaOperadores(const EstatisticaOperador *pOperadores);
+
+// Estado da busca local que Objective() le e atualiza. As threads do pool
+// (opcao -t) e das ilhas (opcao -d) comecam de uma copia do estado da thread
+// principal e devolvem o seu, que a thread principal mescla.
+struct EstadoBuscaLocal {
+    int bestScorePermutacao;
+    int bestScoreInsercao;
+    int bestScoreInsercaoCompleta;
+    vector<int> listaSolucaoPermutacao;
+    vector<int> listaSolucaoInsercao;
+    vector<int> listaSolucaoInsercaoCompleta;
+    int intSolucoesFactiveis;
+    int intSolucoesNaoFactiveis;
+    unsigned long iCacheHits;
+    unsigned long iCacheMisses;
+    EstatisticaOperador operadores[NOPERADORES];
+};
+void salvaEstadoBusca(EstadoBuscaLocal &pEstado);
+void restauraEstadoBusca(const EstadoBuscaLocal &pEstado);
+void mesclaEstadoBusca(const EstadoBuscaLocal &pEstado);
+void preparaThreadAvaliacao();
+ostream &saidaAvaliacao();
+
+// Avaliacao da populacao do AG pelo pool de threads (opcao -t)
+void avaliaPopulacaoParalela(GAPopulation &p);
+void configuraAvaliador(GAGeneticAlgorithm &ga);
+
+// Ilhas do AG, uma por thread (opcao -d): estado inicial e estado final de
+// cada ilha, ver GAThreadedDemeGA::threadHooks()
+struct EstadoIlhas {
+    EstadoBuscaLocal inicial;
+    vector<EstadoBuscaLocal> resultados;
+};
+void iniciaThreadIlha(int intIlha, void *pDados);
+void terminaThreadIlha(int intIlha, void *pDados);
 //Global variable declarations
 
 std::stringstream ssResult;
 
-int R[MACHINE*JOB];
-int T[JOB*MACHINE];
-int vetBestSequence[JOB*MACHINE];
+Instance instancia; // Instancia em execucao: dimensoes, rotas (R) e tempos (T)
+vector<int> vetRotas;  // Armazenamento de R, dimensionado pela instancia
+vector<int> vetTempos; // Armazenamento de T, dimensionado pela instancia
+int *R;
+int *T;
+vector<int> vetBestSequence;
+thread_local EvalContext ctxAvaliacao; // Contexto de avaliacao das sementes (aponta para R e T), um por thread
+vector<int> vetCabecas; // Cabecas (inicio) das operacoes, ver findCriticalPath()
+vector<int> vetCaudas;  // Caudas das operacoes, ver findCriticalPath()
+thread_local LoteSementes loteVizinhos; // Candidatas das vizinhancas, reaproveitado a cada lote
 
 string Con;
 string Bsi;
@@ -141,7 +260,7 @@ int intInstancia = 1; // N
 int outIter = 2; // quantidade de iteraes externas
 string strSemente;
 
-int score_ant = ITER;
+int score_ant; // inicializado em reiniciaEstado()
 bool primeira_geracao_s=true, primeira_geracao;
 int *s;
 double start = clock();
@@ -154,7 +273,7 @@ vector <int> score_rodada_anterior(nBestIndividuals);
 vector <int> bestSeedsIndex(nBestIndividuals);
 vector <int> scoreTopList(nBestIndividuals);
 std::vector<int>::iterator it;
-int bestCurrent = ITER;
+int bestCurrent; // inicializado em reiniciaEstado()
 int seedIndexCurrent = 0;
 //vector<int> firstSeed(s, s+MACHINE*JOB);
 vector <vector <int> > S(nBestIndividuals);//, vector<int>(MACHINE*JOB));
@@ -163,8 +282,22 @@ bool STOP = false;
 bool cpBasedSeed = false;
 
 // VARIVEIS DO HISTRICO
-int intSolucoesFactiveis;
-int intSolucoesNaoFactiveis;
+thread_local int intSolucoesFactiveis;
+thread_local int intSolucoesNaoFactiveis;
+
+// Threads do pool e das ilhas: cada uma tem seu contexto de avaliacao e seu
+// estado de busca local (as variaveis thread_local acima), refeitos quando a
+// instancia muda (intGeracaoInstancia e incrementada em SetProblema)
+int intGeracaoInstancia = 0;
+int intIlhas = 0; // ilhas do AG (opcao -d); 0 = AG de estado estacionario
+int intTabuIteracoes = 0; // iteracoes da busca tabu apos o AG (opcao -tabu); 0 = localSearch()
+double dblTabuSegundos = 0; // limite de tempo de cada busca tabu (opcao -tabut); 0 = sem limite
+bool bPermutacaoCompleta = false; // permutacao() troca todos os pares de cada maquina (opcao -permc)
+bool bOperadoresFixos = false; // Objective() roda todos os operadores em cada semente (opcao -opfixo)
+bool bPoolVizinhanca = false; // pool nos lotes de vizinhos e populacao em serie (opcao -tv)
+thread_local EstatisticaOperador vetOperadores[NOPERADORES];
+const char *NOMEOPERADOR[NOPERADORES] = {"permutao", "insero", "insero completa"};
+thread_local bool threadAuxiliar = false;
 // string strSementeInicial = "NO FACTVEL";
 
 //User-defined function
@@ -633,596 +766,361 @@ void * AtualizarVetorComArray( int pVetorP[], vector<int> pArrayBase){
 
 } // void AtualizarVetorComVetor( * int pvetorP, *int pVetorBase){
 
-int SetProblem( int argc, char **argv ){
-    int r=0, t=0;
-    string strProblema;
-    string strInstancia = "2";
-
-    // 1o parametro indica a abordagem a ser explorada
-    if (argc > 1) {
-        intAbordagem = atoi(argv[1]);
-    } else {
-        intAbordagem = 2; // 1=No Factvel; 2=FIFO; 3=FIFO + SPT; 4=FIFO + LPT; 5=NEH
-    }
-
-    // 2o parametro indica o problema LAxx
-    if (argc > 2) {
-        strProblema = argv[2];
-        intProblema = atoi(argv[2]);
-
-    } else {
-        #ifdef PROGRAMA_01
-            intProblema = 1; // LA01
-            strProblema = "1";
-
-        #endif
+// Avalia a semente diretamente pela ordem das operacoes nas maquinas,
+// sem montar a matriz de prioridades (mesmo resultado de factivel()).
+int avaliaSemente(const vector<int> &pSemente){
 
-        #ifdef PROGRAMA_06
-            intProblema = 6;
-            strProblema = "6";
+    return decodeSeed(&ctxAvaliacao, &pSemente[0], NULL);
 
-        #endif
+} // int avaliaSemente(const vector<int> &pSemente){
 
-        #ifdef PROGRAMA_11
-            intProblema = 11;
-            strProblema = "11";
+// Igual a avaliaSemente(), para quem so quer saber se a semente bate
+// intLimite: a avaliacao para assim que o makespan nao pode ficar abaixo
+// dele e devolve um valor >= intLimite ("nao melhora").
+int avaliaSementeLimite(const vector<int> &pSemente, int intLimite){
 
-        #endif
+    return decodeSeedCutoff(&ctxAvaliacao, &pSemente[0], intLimite);
 
-        #ifdef PROGRAMA_16
-            intProblema = 16;
-            strProblema = "16";
+} // int avaliaSementeLimite(const vector<int> &pSemente, int intLimite){
 
-        #endif
+// Estimativa (limite inferior) do makespan apos trocar as posicoes intPos e
+// intPos+1 da semente, na mesma maquina. Usa as cabecas e caudas calculadas
+// por findCriticalPath(pSemente), sem reavaliar a semente.
+int estimaTroca(const vector<int> &pSemente, int intPos){
 
-        #ifdef PROGRAMA_21
-            intProblema = 21;
-            strProblema = "21";
+    return swapEstimate(&ctxAvaliacao, &pSemente[0], &vetCabecas[0], &vetCaudas[0],
+                        intPos / JOB, intPos % JOB);
 
-        #endif
-    }
+} // int estimaTroca(const vector<int> &pSemente, int intPos){
 
-    // 3o parametro indica a quantidade de iteraes
-    if (argc > 3) {
-        outIter = atoi(argv[3]);
-    }
+// Indice de posicoes da semente: pPosicoes[maq*JOB + job] (0-index) e a
+// posicao em pSemente do job naquela maquina, sem std::find na semente
+void indexaSemente(const vector<int> &pSemente, vector<int> &pPosicoes){
 
-    if (argc > 4 ){
-        intInstancia = atoi(argv[4]);
-        strInstancia = argv[4];
-    }
+    pPosicoes.resize(MACHINE*JOB);
+    seedPositions(&ctxAvaliacao, &pSemente[0], &pPosicoes[0]);
 
+} // void indexaSemente(const vector<int> &pSemente, vector<int> &pPosicoes){
 
-    switch (intAbordagem) {
-    case 1:
-        strSemente = "Nao Factivel";
-        break;
-    case 2:
-        strSemente = "FIFO";
-        break;
-    case 3:
-        strSemente = "FIFO+SPT";
-        break;
-    case 4:
-        strSemente = "FIFO+LPT";
-        break;
-    case 5:
-        strSemente = "NEH_CP";
-        break;
-    }
+// Troca as posicoes intPos1 e intPos2 (mesma maquina) da semente, mantendo
+// o indice de posicoes em dia
+void trocaSemente(vector<int> &pSemente, vector<int> &pPosicoes, int intPos1, int intPos2){
 
-    Con="\\LA" + strProblema + "_Convergence_" + strSemente + "_" + strInstancia + ".txt";
-    His="\\LA" + strProblema + "_History.csv";
-    Bsi="\\LA" + strProblema + "_BestSequenceIdentified_" + strSemente + "_" + strInstancia + ".txt";
-    Sch="\\LA" + strProblema + "_Scheduling_" + strSemente + "_" + strInstancia + ".csv";
+    seedSwap(&ctxAvaliacao, &pSemente[0], &pPosicoes[0], intPos1, intPos2);
 
-    ArqHis = PastaDesktop + His;
-    ArqCon = PastaDesktop + Con;
-    ArqBsi = PastaDesktop + Bsi;
-    ArqSch = PastaDesktop + Sch;
+} // void trocaSemente(vector<int> &pSemente, vector<int> &pPosicoes, int intPos1, int intPos2){
 
-    #ifdef PROGRAMA_01
+// Trocas adjacentes que o genoma manda fazer: posicao j*JOB+i da semente
+// para cada gene(i,j) == 1, andando so pelos bits ligados do genoma. Na
+// mesma maquina (linha j) as trocas ficam em ordem crescente de i, como no
+// laco por colunas; maquinas diferentes nao interferem umas nas outras
+void listaTrocasGenoma(const GA2DBinaryStringGenome &pGenoma, vector<int> &pTrocas){
 
-        if (intProblema == 1){
-            intMakeSpanOtimo = 666;
+    unsigned int intLargura = pGenoma.width();
+    unsigned int intBits = pGenoma.GABinaryString::size();
 
-            R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3;       T[t++]=21; T[t++]=53; T[t++]=95; T[t++]=55; T[t++]=34;
-            R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=2;       T[t++]=21; T[t++]=52; T[t++]=16; T[t++]=26; T[t++]=71;
-            R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3; R[r++]=1;       T[t++]=39; T[t++]=98; T[t++]=42; T[t++]=31; T[t++]=12;
-            R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4;       T[t++]=77; T[t++]=55; T[t++]=79; T[t++]=66; T[t++]=77;
-            R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=5;       T[t++]=83; T[t++]=34; T[t++]=64; T[t++]=19; T[t++]=37;
-            R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4;       T[t++]=54; T[t++]=43; T[t++]=79; T[t++]=92; T[t++]=62;
-            R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3; R[r++]=1;       T[t++]=69; T[t++]=77; T[t++]=87; T[t++]=87; T[t++]=93;
-            R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=5;       T[t++]=38; T[t++]=60; T[t++]=41; T[t++]=24; T[t++]=83;
-            R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=3;       T[t++]=17; T[t++]=49; T[t++]=25; T[t++]=44; T[t++]=98;
-            R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=1;       T[t++]=77; T[t++]=79; T[t++]=43; T[t++]=75; T[t++]=96;
-
-        } else if(intProblema == 2) {
-            intMakeSpanOtimo = 655;
-
-            R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=3;       T[t++]=20; T[t++]=87; T[t++]=31; T[t++]=76; T[t++]=17;
-            R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4;       T[t++]=25; T[t++]=32; T[t++]=24; T[t++]=18; T[t++]=81;
-            R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4;       T[t++]=72; T[t++]=23; T[t++]=28; T[t++]=58; T[t++]=99;
-            R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=4;       T[t++]=86; T[t++]=76; T[t++]=97; T[t++]=45; T[t++]=90;
-            R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2;       T[t++]=27; T[t++]=42; T[t++]=48; T[t++]=17; T[t++]=46;
-            R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3;       T[t++]=67; T[t++]=98; T[t++]=48; T[t++]=27; T[t++]=62;
-            R[r++]=5; R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=3;       T[t++]=28; T[t++]=12; T[t++]=19; T[t++]=80; T[t++]=50;
-            R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4; R[r++]=5;       T[t++]=63; T[t++]=94; T[t++]=98; T[t++]=50; T[t++]=80;
-            R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=4;       T[t++]=14; T[t++]=75; T[t++]=50; T[t++]=41; T[t++]=55;
-            R[r++]=5; R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=1;       T[t++]=72; T[t++]=18; T[t++]=37; T[t++]=79; T[t++]=61;
-
-        } else if(intProblema == 3) {
-            intMakeSpanOtimo = 597;
-
-            R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=4;       T[t++]=23; T[t++]=45; T[t++]=82; T[t++]=84; T[t++]=38;
-            R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4;       T[t++]=21; T[t++]=29; T[t++]=18; T[t++]=41; T[t++]=50;
-            R[r++]=3; R[r++]=4; R[r++]=5; R[r++]=1; R[r++]=2;       T[t++]=38; T[t++]=54; T[t++]=16; T[t++]=52; T[t++]=52;
-            R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=4;       T[t++]=37; T[t++]=54; T[t++]=74; T[t++]=62; T[t++]=57;
-            R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=3;       T[t++]=57; T[t++]=81; T[t++]=61; T[t++]=68; T[t++]=30;
-            R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=4;       T[t++]=81; T[t++]=79; T[t++]=89; T[t++]=89; T[t++]=11;
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2;       T[t++]=33; T[t++]=20; T[t++]=91; T[t++]=20; T[t++]=66;
-            R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4;       T[t++]=24; T[t++]=84; T[t++]=32; T[t++]=55; T[t++]= 8;
-            R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2;       T[t++]=56; T[t++]= 7; T[t++]=54; T[t++]=64; T[t++]=39;
-            R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4;       T[t++]=40; T[t++]=83; T[t++]=19; T[t++]= 8; T[t++]= 7;
-
-        } else if(intProblema == 4) {
-            intMakeSpanOtimo = 590;
-
-            R[r++]=1; R[r++]=3; R[r++]=4; R[r++]=5; R[r++]=2;       T[t++]=12; T[t++]=94; T[t++]=92; T[t++]=91; T[t++]= 7;
-            R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1;       T[t++]=19; T[t++]=11; T[t++]=66; T[t++]=21; T[t++]=87;
-            R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3;       T[t++]=14; T[t++]=75; T[t++]=13; T[t++]=16; T[t++]=20;
-            R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=2;       T[t++]=95; T[t++]=66; T[t++]= 7; T[t++]= 7; T[t++]=77;
-            R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1; R[r++]=3;       T[t++]=45; T[t++]= 6; T[t++]=89; T[t++]=15; T[t++]=34;
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2;       T[t++]=77; T[t++]=20; T[t++]=76; T[t++]=88; T[t++]=53;
-            R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5;       T[t++]=74; T[t++]=88; T[t++]=52; T[t++]=27; T[t++]= 9;
-            R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3;       T[t++]=88; T[t++]=69; T[t++]=62; T[t++]=98; T[t++]=52;
-            R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4;       T[t++]=61; T[t++]= 9; T[t++]=62; T[t++]=52; T[t++]=90;
-            R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=54; T[t++]= 5; T[t++]=59; T[t++]=15; T[t++]=88;
+    pTrocas.clear();
+    for (unsigned int b = pGenoma.next(0); b < intBits; b = pGenoma.next(b + 1)) {
+        pTrocas.push_back((b / intLargura) * JOB + b % intLargura);
+    }
 
-        } else if(intProblema == 5) {
-            intMakeSpanOtimo = 593;
+} // void listaTrocasGenoma(const GA2DBinaryStringGenome &pGenoma, vector<int> &pTrocas){
 
-            R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4;       T[t++]=72; T[t++]=87; T[t++]=95; T[t++]=66; T[t++]=60;
-            R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=3; R[r++]=2;       T[t++]= 5; T[t++]=35; T[t++]=48; T[t++]=39; T[t++]=54;
-            R[r++]=2; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5;       T[t++]=46; T[t++]=20; T[t++]=21; T[t++]=97; T[t++]=55;
-            R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3;       T[t++]=59; T[t++]=19; T[t++]=46; T[t++]=34; T[t++]=37;
-            R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=23; T[t++]=73; T[t++]=25; T[t++]=24; T[t++]=28;
-            R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=2; R[r++]=3;       T[t++]=28; T[t++]=45; T[t++]= 5; T[t++]=78; T[t++]=83;
-            R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=3;       T[t++]=53; T[t++]=71; T[t++]=37; T[t++]=29; T[t++]=12;
-            R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=12; T[t++]=87; T[t++]=33; T[t++]=55; T[t++]=38;
-            R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=5;       T[t++]=49; T[t++]=83; T[t++]=40; T[t++]=48; T[t++]= 7;
-            R[r++]=3; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=2;       T[t++]=65; T[t++]=17; T[t++]=90; T[t++]=27; T[t++]=23;
+// Aplica na semente as trocas de listaTrocasGenoma()
+void applyGenomeToSeed(vector<int> &pSemente, const vector<int> &pTrocas){
 
-        } else {
-            printf( "Problema deve estar entre LA01 e LA05");
-            //getchar();
-            return 0; // 0 = erro
+    for (size_t t = 0; t < pTrocas.size(); t++) {
+        swap(pSemente[pTrocas[t]], pSemente[pTrocas[t] + 1]);
+    }
 
-        }
+} // void applyGenomeToSeed(vector<int> &pSemente, const vector<int> &pTrocas){
 
-    #endif
+void applyGenomeToSeed(vector<int> &pSemente, const GA2DBinaryStringGenome &pGenoma){
 
-    #ifdef PROGRAMA_06
-        if (intProblema == 6){
-            intMakeSpanOtimo = 926;
+    static thread_local vector<int> trocas;
 
-            R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4;       T[t++]=21; T[t++]=34; T[t++]=95; T[t++]=53; T[t++]=55;
-            R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3; R[r++]=1;       T[t++]=52; T[t++]=16; T[t++]=71; T[t++]=26; T[t++]=21;
-            R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=5;       T[t++]=31; T[t++]=12; T[t++]=42; T[t++]=39; T[t++]=98;
-            R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=3;       T[t++]=77; T[t++]=77; T[t++]=79; T[t++]=55; T[t++]=66;
-            R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=1;       T[t++]=37; T[t++]=34; T[t++]=64; T[t++]=19; T[t++]=83;
-            R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5;       T[t++]=43; T[t++]=54; T[t++]=92; T[t++]=62; T[t++]=79;
-            R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=3;       T[t++]=93; T[t++]=69; T[t++]=87; T[t++]=77; T[t++]=87;
-            R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4;       T[t++]=60; T[t++]=41; T[t++]=38; T[t++]=83; T[t++]=24;
-            R[r++]=3; R[r++]=4; R[r++]=5; R[r++]=1; R[r++]=2;       T[t++]=98; T[t++]=17; T[t++]=25; T[t++]=44; T[t++]=49;
-            R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3;       T[t++]=96; T[t++]=77; T[t++]=79; T[t++]=75; T[t++]=43;
-            R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=4; R[r++]=2;       T[t++]=28; T[t++]=35; T[t++]=95; T[t++]=76; T[t++]= 7;
-            R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=2; R[r++]=4;       T[t++]=61; T[t++]=10; T[t++]=95; T[t++]= 9; T[t++]=35;
-            R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1;       T[t++]=59; T[t++]=16; T[t++]=91; T[t++]=59; T[t++]=46;
-            R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4;       T[t++]=43; T[t++]=52; T[t++]=28; T[t++]=27; T[t++]=50;
-            R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4;       T[t++]=87; T[t++]=45; T[t++]=39; T[t++]= 9; T[t++]=41;
+    listaTrocasGenoma(pGenoma, trocas);
+    applyGenomeToSeed(pSemente, trocas);
 
-        } else if(intProblema == 7) {
-            intMakeSpanOtimo = 890;
+} // void applyGenomeToSeed(vector<int> &pSemente, const GA2DBinaryStringGenome &pGenoma){
 
-            R[r++]=1; R[r++]=5; R[r++]=2; R[r++]=4; R[r++]=3; 		T[t++]=47; T[t++]=57; T[t++]=71; T[t++]=96; T[t++]=14;
-            R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4; R[r++]=3; 		T[t++]=75; T[t++]=60; T[t++]=22; T[t++]=79; T[t++]=65;
-            R[r++]=4; R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=5; 		T[t++]=32; T[t++]=33; T[t++]=69; T[t++]=31; T[t++]=58;
-            R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4; R[r++]=3; 		T[t++]=44; T[t++]=34; T[t++]=51; T[t++]=58; T[t++]=47;
-            R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=29; T[t++]=44; T[t++]=62; T[t++]=17; T[t++]= 8;
-            R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=4; 		T[t++]=15; T[t++]=40; T[t++]=97; T[t++]=38; T[t++]=66;
-            R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; 		T[t++]=58; T[t++]=39; T[t++]=57; T[t++]=20; T[t++]=50;
-            R[r++]=3; R[r++]=4; R[r++]=5; R[r++]=1; R[r++]=2; 		T[t++]=57; T[t++]=32; T[t++]=87; T[t++]=63; T[t++]=21;
-            R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=4; 		T[t++]=56; T[t++]=84; T[t++]=90; T[t++]=85; T[t++]=61;
-            R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=3; 		T[t++]=15; T[t++]=20; T[t++]=67; T[t++]=30; T[t++]=70;
-            R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=4; 		T[t++]=84; T[t++]=82; T[t++]=23; T[t++]=45; T[t++]=38;
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2; 		T[t++]=50; T[t++]=21; T[t++]=18; T[t++]=41; T[t++]=29;
-            R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4; 		T[t++]=16; T[t++]=52; T[t++]=52; T[t++]=38; T[t++]=54;
-            R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=37; T[t++]=54; T[t++]=57; T[t++]=74; T[t++]=62;
-            R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4; 		T[t++]=57; T[t++]=61; T[t++]=81; T[t++]=30; T[t++]=68;
+// Maquina (1-index) e posicao na semente de cada operacao do caminho critico
+// (menos o no inicial 0), para os lacos aninhados das buscas locais
+void indexaCaminhoCritico(const vector<int> &pPosicoes, vector<int> &pMaquinas, vector<int> &pPosCaminho){
 
-        } else if(intProblema ==8) {
-            intMakeSpanOtimo =863;
+    int intTamanho = currentCriticalPath.size() > 0 ? currentCriticalPath.size() - 1 : 0;
 
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2;       T[t++]=92; T[t++]=94; T[t++]=12; T[t++]=91; T[t++]=07;
-            R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5;       T[t++]=21; T[t++]=19; T[t++]=87; T[t++]=11; T[t++]=66;
-            R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3;       T[t++]=14; T[t++]=13; T[t++]=75; T[t++]=16; T[t++]=20;
-            R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4;       T[t++]=95; T[t++]=66; T[t++]=07; T[t++]=77; T[t++]=07;
-            R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=34; T[t++]=89; T[t++]=06; T[t++]=45; T[t++]=15;
-            R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=1;       T[t++]=88; T[t++]=77; T[t++]=20; T[t++]=53; T[t++]=76;
-            R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2; R[r++]=3;       T[t++]= 9; T[t++]=27; T[t++]=52; T[t++]=88; T[t++]=74;
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=5;       T[t++]=69; T[t++]=52; T[t++]=62; T[t++]=88; T[t++]=98;
-            R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=2;       T[t++]=90; T[t++]=62; T[t++]= 9; T[t++]=61; T[t++]=52;
-            R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=1; R[r++]=2;       T[t++]= 5; T[t++]=54; T[t++]=59; T[t++]=88; T[t++]=15;
-            R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4; R[r++]=3;       T[t++]=41; T[t++]=50; T[t++]=78; T[t++]=53; T[t++]=23;
-            R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2;       T[t++]=38; T[t++]=72; T[t++]=91; T[t++]=68; T[t++]=71;
-            R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=2;       T[t++]=45; T[t++]=95; T[t++]=52; T[t++]=25; T[t++]= 6;
-            R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=3;       T[t++]=30; T[t++]=66; T[t++]=23; T[t++]=36; T[t++]=17;
-            R[r++]=3; R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5;       T[t++]=95; T[t++]=71; T[t++]=76; T[t++]= 8; T[t++]=88;
+    pMaquinas.resize(intTamanho);
+    pPosCaminho.resize(intTamanho);
 
-        } else if(intProblema ==9) {
-            intMakeSpanOtimo =951;
+    for (int i = 0; i < intTamanho; i++) {
+        int op = currentCriticalPath[i] - 1;
+        pMaquinas[i] = R[op];
+        pPosCaminho[i] = pPosicoes[(R[op] - 1) * JOB + op / MACHINE];
+    }
 
-            R[r++]=2; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5;       T[t++]=66; T[t++]=85; T[t++]=84; T[t++]=62; T[t++]=19;
-            R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1;       T[t++]=59; T[t++]=64; T[t++]=46; T[t++]=13; T[t++]=25;
-            R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1;       T[t++]=88; T[t++]=80; T[t++]=73; T[t++]=53; T[t++]=41;
-            R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=4; R[r++]=5;       T[t++]=14; T[t++]=67; T[t++]=57; T[t++]=74; T[t++]=47;
-            R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2;       T[t++]=84; T[t++]=64; T[t++]=41; T[t++]=84; T[t++]=78;
-            R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=5;       T[t++]=63; T[t++]=28; T[t++]=46; T[t++]=26; T[t++]=52;
-            R[r++]=4; R[r++]=3; R[r++]=5; R[r++]=2; R[r++]=1;       T[t++]=10; T[t++]=17; T[t++]=73; T[t++]=11; T[t++]=64;
-            R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1;       T[t++]=67; T[t++]=97; T[t++]=95; T[t++]=38; T[t++]=85;
-            R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4;       T[t++]=95; T[t++]=46; T[t++]=59; T[t++]=65; T[t++]=93;
-            R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=43; T[t++]=85; T[t++]=32; T[t++]=85; T[t++]=60;
-            R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=2;       T[t++]=49; T[t++]=41; T[t++]=61; T[t++]=66; T[t++]=90;
-            R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3;       T[t++]=17; T[t++]=23; T[t++]=70; T[t++]=99; T[t++]=49;
-            R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2; R[r++]=3;       T[t++]=40; T[t++]=73; T[t++]=73; T[t++]=98; T[t++]=68;
-            R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5;       T[t++]=57; T[t++]= 9; T[t++]= 7; T[t++]=13; T[t++]=98;
-            R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4;       T[t++]=37; T[t++]=85; T[t++]=17; T[t++]=79; T[t++]=41;
+} // void indexaCaminhoCritico(const vector<int> &pPosicoes, vector<int> &pMaquinas, vector<int> &pPosCaminho){
+
+// Operacoes criticas de pSemente por posicao da semente: pBloco[pos] e o
+// numero (1, 2, ...) do bloco critico da operacao, 0 se ela nao for critica,
+// e pExtremo[pos] = 1 na primeira e na ultima operacao de cada bloco; as
+// cabecas e caudas das operacoes ficam em pCabecas e pCaudas. Uma
+// operacao e critica se cabeca + tempo + cauda = makespan (esta em algum
+// caminho critico); o bloco segue na maquina enquanto a seguinte e critica e
+// comeca quando a anterior termina. Nao usa currentCriticalPath (que pega o
+// antecessor de maior cabeca, nem sempre o que termina junto) e roda nas
+// threads do pool. Devolve o makespan (ITER se a semente nao for factivel,
+// com os vetores so zerados).
+int marcaBlocosCriticos(const vector<int> &pSemente, vector<int> &pBloco, vector<char> &pExtremo,
+                        vector<int> &pCabecas, vector<int> &pCaudas){
+
+    static thread_local vector<int> opJobMaquina;
+    const int *vTempos = ctxAvaliacao.vTimes;
+
+    pCabecas.resize(MACHINE*JOB);
+    pCaudas.resize(MACHINE*JOB);
+    opJobMaquina.resize(MACHINE*JOB);
+    pBloco.assign(MACHINE*JOB, 0);
+    pExtremo.assign(MACHINE*JOB, 0);
+
+    int intMakespan = analyzeSeed(&ctxAvaliacao, &pSemente[0], &pCabecas[0], &pCaudas[0], NULL, NULL);
+    if (intMakespan >= ITER) {
+        return intMakespan;
+    }
 
-        } else if(intProblema ==10) {
-            intMakeSpanOtimo =958;
+    // Operacao (job*MACHINE + passo) do job em cada maquina
+    for (int op = 0; op < MACHINE*JOB; op++) {
+        opJobMaquina[(op / MACHINE) * MACHINE + R[op] - 1] = op;
+    }
 
-            R[r++]=2; R[r++]=3; R[r++]=4; R[r++]=1; R[r++]=5;       T[t++]=58; T[t++]=44; T[t++]= 5; T[t++]= 9; T[t++]=58;
-            R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3;       T[t++]=89; T[t++]=97; T[t++]=96; T[t++]=77; T[t++]=84;
-            R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4;       T[t++]=77; T[t++]=87; T[t++]=81; T[t++]=39; T[t++]=85;
-            R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5;       T[t++]=57; T[t++]=21; T[t++]=31; T[t++]=15; T[t++]=73;
-            R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=5;       T[t++]=48; T[t++]=40; T[t++]=49; T[t++]=70; T[t++]=71;
-            R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2;       T[t++]=34; T[t++]=82; T[t++]=80; T[t++]=10; T[t++]=22;
-            R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=4;       T[t++]=91; T[t++]=75; T[t++]=55; T[t++]=17; T[t++]= 7;
-            R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=1;       T[t++]=62; T[t++]=47; T[t++]=72; T[t++]=35; T[t++]=11;
-            R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3;       T[t++]=64; T[t++]=75; T[t++]=50; T[t++]=90; T[t++]=94;
-            R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2;       T[t++]=67; T[t++]=20; T[t++]=15; T[t++]=12; T[t++]=71;
-            R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2;       T[t++]=52; T[t++]=93; T[t++]=68; T[t++]=29; T[t++]=57;
-            R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4;       T[t++]=70; T[t++]=58; T[t++]=93; T[t++]= 7; T[t++]=77;
-            R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=1;       T[t++]=27; T[t++]=82; T[t++]=63; T[t++]= 6; T[t++]=95;
-            R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4;       T[t++]=87; T[t++]=56; T[t++]=36; T[t++]=26; T[t++]=48;
-            R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2;       T[t++]=76; T[t++]=36; T[t++]=36; T[t++]=15; T[t++]= 8;
+    int intBloco = 0;
+    for (int m = 0; m < MACHINE; m++) {
+        int intOpAnterior = -1;
 
-        } else {
-            printf( "Problema deve estar entre LA06 e LA10");
-            //getchar();
-            return 0; // 0 = erro
+        for (int pos = m*JOB; pos < (m+1)*JOB; pos++) {
+            int op = opJobMaquina[(pSemente[pos] - 1) * MACHINE + m];
 
+            if (pCabecas[op] + vTempos[op] + pCaudas[op] != intMakespan) {
+                if (intOpAnterior >= 0) {
+                    pExtremo[pos-1] = 1;
+                }
+                intOpAnterior = -1;
+                continue;
+            }
+            if (intOpAnterior < 0 || pCabecas[intOpAnterior] + vTempos[intOpAnterior] != pCabecas[op]) {
+                if (intOpAnterior >= 0) {
+                    pExtremo[pos-1] = 1;
+                }
+                intBloco++;
+                pExtremo[pos] = 1;
+            }
+            pBloco[pos] = intBloco;
+            intOpAnterior = op;
+        }
+        if (intOpAnterior >= 0) {
+            pExtremo[(m+1)*JOB-1] = 1;
         }
+    }
 
-    #endif
+    return intMakespan;
 
-    #ifdef PROGRAMA_11
-        if (intProblema == 11){
-            intMakeSpanOtimo = 1222;
+} // int marcaBlocosCriticos(...)
 
-			R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; 		T[t++]= 5; T[t++]=58; T[t++]=44; T[t++]= 9; T[t++]=58;
-			R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=4; 		T[t++]=89; T[t++]=96; T[t++]=97; T[t++]=84; T[t++]=77;
-			R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=1; 		T[t++]=81; T[t++]=85; T[t++]=87; T[t++]=39; T[t++]=77;
-			R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3; 		T[t++]=15; T[t++]=57; T[t++]=73; T[t++]=21; T[t++]=31;
-			R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2; 		T[t++]=48; T[t++]=71; T[t++]=70; T[t++]=40; T[t++]=49;
-			R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=10; T[t++]=82; T[t++]=34; T[t++]=80; T[t++]=22;
-			R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4; 		T[t++]=17; T[t++]=55; T[t++]=91; T[t++]=75; T[t++]= 7;
-			R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=1; 		T[t++]=47; T[t++]=62; T[t++]=72; T[t++]=35; T[t++]=11;
-			R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; 		T[t++]=90; T[t++]=94; T[t++]=50; T[t++]=64; T[t++]=75;
-			R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2; 		T[t++]=15; T[t++]=67; T[t++]=12; T[t++]=20; T[t++]=71;
-			R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; 		T[t++]=93; T[t++]=29; T[t++]=52; T[t++]=57; T[t++]=68;
-			R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=77; T[t++]=93; T[t++]=58; T[t++]=70; T[t++]= 7;
-			R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3; 		T[t++]=63; T[t++]=27; T[t++]=95; T[t++]= 6; T[t++]=82;
-			R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=36; T[t++]=26; T[t++]=48; T[t++]=56; T[t++]=87;
-			R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=4; R[r++]=1; 		T[t++]=36; T[t++]= 8; T[t++]=15; T[t++]=76; T[t++]=36;
-			R[r++]=5; R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=3; 		T[t++]=78; T[t++]=84; T[t++]=41; T[t++]=30; T[t++]=76;
-			R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; 		T[t++]=78; T[t++]=75; T[t++]=88; T[t++]=13; T[t++]=81;
-			R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=2; R[r++]=4; 		T[t++]=54; T[t++]=40; T[t++]=13; T[t++]=82; T[t++]=29;
-			R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; 		T[t++]=26; T[t++]=82; T[t++]=52; T[t++]= 6; T[t++]= 6;
-			R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=54; T[t++]=64; T[t++]=54; T[t++]=32; T[t++]=88;
+// Estimativa do makespan apos levar a operacao da posicao intDe da semente
+// para a posicao intPara (mesma maquina), com as cabecas e caudas de
+// marcaBlocosCriticos(pSemente). ITER se o movimento puder fechar um ciclo.
+int estimaInsercao(const vector<int> &pSemente, const vector<int> &pCabecas, const vector<int> &pCaudas,
+                   int intDe, int intPara){
 
-        } else if(intProblema == 12) {
-            intMakeSpanOtimo = 1039;
+    return insertEstimate(&ctxAvaliacao, &pSemente[0], &pCabecas[0], &pCaudas[0],
+                          intDe / JOB, intDe % JOB, intPara % JOB);
 
-			R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; 		T[t++]=23; T[t++]=82; T[t++]=84; T[t++]=45; T[t++]=38;
-			R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=1; R[r++]=3; 		T[t++]=50; T[t++]=41; T[t++]=29; T[t++]=18; T[t++]=21;
-			R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; 		T[t++]=16; T[t++]=54; T[t++]=52; T[t++]=38; T[t++]=52;
-			R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; 		T[t++]=62; T[t++]=57; T[t++]=37; T[t++]=74; T[t++]=54;
-			R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5; 		T[t++]=68; T[t++]=61; T[t++]=30; T[t++]=81; T[t++]=57;
-			R[r++]=2; R[r++]=3; R[r++]=4; R[r++]=1; R[r++]=5; 		T[t++]=89; T[t++]=89; T[t++]=11; T[t++]=79; T[t++]=81;
-			R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3; 		T[t++]=66; T[t++]=91; T[t++]=33; T[t++]=20; T[t++]=20;
-			R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; 		T[t++]= 8; T[t++]=24; T[t++]=55; T[t++]=32; T[t++]=84;
-			R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=4; 		T[t++]= 7; T[t++]=64; T[t++]=39; T[t++]=56; T[t++]=54;
-			R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=19; T[t++]=40; T[t++]= 7; T[t++]= 8; T[t++]=83;
-			R[r++]=1; R[r++]=3; R[r++]=4; R[r++]=5; R[r++]=2; 		T[t++]=63; T[t++]=64; T[t++]=91; T[t++]=40; T[t++]= 6;
-			R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; 		T[t++]=42; T[t++]=61; T[t++]=15; T[t++]=98; T[t++]=74;
-			R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3; 		T[t++]=80; T[t++]=26; T[t++]=75; T[t++]= 6; T[t++]=87;
-			R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=2; 		T[t++]=39; T[t++]=22; T[t++]=75; T[t++]=24; T[t++]=44;
-			R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1; R[r++]=3; 		T[t++]=15; T[t++]=79; T[t++]= 8; T[t++]=12; T[t++]=20;
-			R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2; 		T[t++]=26; T[t++]=43; T[t++]=80; T[t++]=22; T[t++]=61;
-			R[r++]=3; R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; 		T[t++]=62; T[t++]=36; T[t++]=63; T[t++]=96; T[t++]=40;
-			R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3; 		T[t++]=33; T[t++]=18; T[t++]=22; T[t++]= 5; T[t++]=10;
-			R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4; 		T[t++]=64; T[t++]=64; T[t++]=89; T[t++]=96; T[t++]=95;
-			R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1; 		T[t++]=18; T[t++]=23; T[t++]=15; T[t++]=38; T[t++]= 8;
+} // int estimaInsercao(...)
 
-        } else if(intProblema ==13) {
-            intMakeSpanOtimo =1150;
+// Esvazia o lote, mantendo a memoria ja alocada
+void loteLimpa(LoteSementes &pLote){
 
-			R[r++]=4; R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=3; 		T[t++]=60; T[t++]=87; T[t++]=72; T[t++]=95; T[t++]=66;
-			R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=4; R[r++]=5; 		T[t++]=54; T[t++]=48; T[t++]=39; T[t++]=35; T[t++]= 5;
-			R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=20; T[t++]=46; T[t++]=97; T[t++]=21; T[t++]=55;
-			R[r++]=3; R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5; 		T[t++]=37; T[t++]=59; T[t++]=19; T[t++]=34; T[t++]=46;
-			R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=5; 		T[t++]=73; T[t++]=25; T[t++]=24; T[t++]=28; T[t++]=23;
-			R[r++]=2; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; 		T[t++]=78; T[t++]=28; T[t++]=83; T[t++]=45; T[t++]= 5;
-			R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; 		T[t++]=71; T[t++]=37; T[t++]=12; T[t++]=29; T[t++]=53;
-			R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; 		T[t++]=12; T[t++]=33; T[t++]=55; T[t++]=87; T[t++]=38;
-			R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=4; R[r++]=5; 		T[t++]=48; T[t++]=40; T[t++]=49; T[t++]=83; T[t++]= 7;
-			R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2; 		T[t++]=90; T[t++]=27; T[t++]=65; T[t++]=17; T[t++]=23;
-			R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=5; 		T[t++]=62; T[t++]=85; T[t++]=66; T[t++]=84; T[t++]=19;
-			R[r++]=4; R[r++]=3; R[r++]=5; R[r++]=2; R[r++]=1; 		T[t++]=59; T[t++]=46; T[t++]=13; T[t++]=64; T[t++]=25;
-			R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1; 		T[t++]=53; T[t++]=73; T[t++]=80; T[t++]=88; T[t++]=41;
-			R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4; 		T[t++]=57; T[t++]=47; T[t++]=14; T[t++]=67; T[t++]=74;
-			R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1; 		T[t++]=41; T[t++]=64; T[t++]=84; T[t++]=78; T[t++]=84;
-			R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=2; 		T[t++]=52; T[t++]=28; T[t++]=26; T[t++]=63; T[t++]=46;
-			R[r++]=2; R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=3; 		T[t++]=11; T[t++]=64; T[t++]=10; T[t++]=73; T[t++]=17;
-			R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2; R[r++]=3; 		T[t++]=38; T[t++]=95; T[t++]=85; T[t++]=97; T[t++]=67;
-			R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; R[r++]=5; 		T[t++]=93; T[t++]=65; T[t++]=95; T[t++]=59; T[t++]=46;
-			R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4; 		T[t++]=60; T[t++]=85; T[t++]=43; T[t++]=85; T[t++]=32;
-
-        } else if(intProblema ==14) {
-            intMakeSpanOtimo =1292;
+    pLote.intQuantidade = 0;
 
-			R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; 		T[t++]= 5; T[t++]=58; T[t++]=44; T[t++]= 9; T[t++]=58;
-			R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=3; R[r++]=4; 		T[t++]=89; T[t++]=96; T[t++]=97; T[t++]=84; T[t++]=77;
-			R[r++]=3; R[r++]=4; R[r++]=2; R[r++]=5; R[r++]=1; 		T[t++]=81; T[t++]=85; T[t++]=87; T[t++]=39; T[t++]=77;
-			R[r++]=1; R[r++]=4; R[r++]=5; R[r++]=2; R[r++]=3; 		T[t++]=15; T[t++]=57; T[t++]=73; T[t++]=21; T[t++]=31;
-			R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=1; R[r++]=2; 		T[t++]=48; T[t++]=71; T[t++]=70; T[t++]=40; T[t++]=49;
-			R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=10; T[t++]=82; T[t++]=34; T[t++]=80; T[t++]=22;
-			R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=5; R[r++]=4; 		T[t++]=17; T[t++]=55; T[t++]=91; T[t++]=75; T[t++]= 7;
-			R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=1; 		T[t++]=47; T[t++]=62; T[t++]=72; T[t++]=35; T[t++]=11;
-			R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; 		T[t++]=90; T[t++]=94; T[t++]=50; T[t++]=64; T[t++]=75;
-			R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=5; R[r++]=2; 		T[t++]=15; T[t++]=67; T[t++]=12; T[t++]=20; T[t++]=71;
-			R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; 		T[t++]=93; T[t++]=29; T[t++]=52; T[t++]=57; T[t++]=68;
-			R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=77; T[t++]=93; T[t++]=58; T[t++]=70; T[t++]= 7;
-			R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=3; 		T[t++]=63; T[t++]=27; T[t++]=95; T[t++]= 6; T[t++]=82;
-			R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=36; T[t++]=26; T[t++]=48; T[t++]=56; T[t++]=87;
-			R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=4; R[r++]=1; 		T[t++]=36; T[t++]= 8; T[t++]=15; T[t++]=76; T[t++]=36;
-			R[r++]=5; R[r++]=2; R[r++]=4; R[r++]=1; R[r++]=3; 		T[t++]=78; T[t++]=84; T[t++]=41; T[t++]=30; T[t++]=76;
-			R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; 		T[t++]=78; T[t++]=75; T[t++]=88; T[t++]=13; T[t++]=81;
-			R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=2; R[r++]=4; 		T[t++]=54; T[t++]=40; T[t++]=13; T[t++]=82; T[t++]=29;
-			R[r++]=2; R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; 		T[t++]=26; T[t++]=82; T[t++]=52; T[t++]= 6; T[t++]= 6;
-			R[r++]=4; R[r++]=2; R[r++]=1; R[r++]=3; R[r++]=5; 		T[t++]=54; T[t++]=64; T[t++]=54; T[t++]=32; T[t++]=88;
+} // void loteLimpa(LoteSementes &pLote){
 
-        } else if(intProblema ==15) {
-            intMakeSpanOtimo =1207;
+// Copia a semente para a proxima coluna do lote, dobrando a capacidade
+// (e reorganizando as colunas) quando o lote esta cheio
+void loteAdiciona(LoteSementes &pLote, const vector<int> &pSemente){
 
-			R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=5; 		T[t++]= 6; T[t++]=40; T[t++]=81; T[t++]=37; T[t++]=19;
-			R[r++]=3; R[r++]=4; R[r++]=1; R[r++]=5; R[r++]=2; 		T[t++]=40; T[t++]=32; T[t++]=55; T[t++]=81; T[t++]= 9;
-			R[r++]=2; R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=1; 		T[t++]=46; T[t++]=65; T[t++]=70; T[t++]=55; T[t++]=77;
-			R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=2; 		T[t++]=21; T[t++]=65; T[t++]=64; T[t++]=25; T[t++]=15;
-			R[r++]=3; R[r++]=1; R[r++]=2; R[r++]=4; R[r++]=5; 		T[t++]=85; T[t++]=40; T[t++]=44; T[t++]=24; T[t++]=37;
-			R[r++]=1; R[r++]=5; R[r++]=2; R[r++]=4; R[r++]=3; 		T[t++]=89; T[t++]=29; T[t++]=83; T[t++]=31; T[t++]=84;
-			R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=1; 		T[t++]=59; T[t++]=38; T[t++]=80; T[t++]=30; T[t++]= 8;
-			R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=5; R[r++]=4; 		T[t++]=80; T[t++]=56; T[t++]=77; T[t++]=41; T[t++]=97;
-			R[r++]=5; R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; 		T[t++]=56; T[t++]=91; T[t++]=50; T[t++]=71; T[t++]=17;
-			R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; 		T[t++]=40; T[t++]=88; T[t++]=59; T[t++]= 7; T[t++]=80;
-			R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=4; 		T[t++]=45; T[t++]=29; T[t++]= 8; T[t++]=77; T[t++]=58;
-			R[r++]=3; R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=5; 		T[t++]=36; T[t++]=54; T[t++]=96; T[t++]= 9; T[t++]=10;
-			R[r++]=1; R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=5; 		T[t++]=28; T[t++]=73; T[t++]=98; T[t++]=92; T[t++]=87;
-			R[r++]=1; R[r++]=4; R[r++]=3; R[r++]=2; R[r++]=5; 		T[t++]=70; T[t++]=86; T[t++]=27; T[t++]=99; T[t++]=96;
-			R[r++]=2; R[r++]=1; R[r++]=5; R[r++]=4; R[r++]=3; 		T[t++]=95; T[t++]=59; T[t++]=56; T[t++]=85; T[t++]=41;
-			R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; 		T[t++]=81; T[t++]=92; T[t++]=32; T[t++]=52; T[t++]=39;
-			R[r++]=2; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=4; 		T[t++]= 7; T[t++]=22; T[t++]=12; T[t++]=88; T[t++]=60;
-			R[r++]=4; R[r++]=1; R[r++]=3; R[r++]=5; R[r++]=2; 		T[t++]=45; T[t++]=93; T[t++]=69; T[t++]=49; T[t++]=27;
-			R[r++]=1; R[r++]=2; R[r++]=3; R[r++]=4; R[r++]=5; 		T[t++]=21; T[t++]=84; T[t++]=61; T[t++]=68; T[t++]=26;
-			R[r++]=2; R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=4; 		T[t++]=82; T[t++]=33; T[t++]=71; T[t++]=99; T[t++]=44;
+    int intTamanho = MACHINE*JOB;
 
-        } else {
-            printf( "Problema deve estar entre LA11 e LA15");
-            //getchar();
-            return 0; // 0 = erro
+    if(pLote.intQuantidade >= pLote.intCapacidade){
+        int intNova = max(2*pLote.intCapacidade, JOB*JOB);
+        vector<int> vetNovo(intTamanho*intNova);
 
+        for(int i = 0; i < intTamanho; i++){
+            for(int c = 0; c < pLote.intQuantidade; c++){
+                vetNovo[i*intNova + c] = pLote.vetSementes[i*pLote.intCapacidade + c];
+            }
         }
 
-    #endif
-
-    #ifdef PROGRAMA_16
-        if (intProblema == 16){
-            intMakeSpanOtimo = 945;
-
-			R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 8; R[r++]= 3; R[r++]= 1; R[r++]= 5; R[r++]= 4; R[r++]= 6; 		T[t++]=21; T[t++]=71; T[t++]=16; T[t++]=52; T[t++]=26; T[t++]=34; T[t++]=53; T[t++]=21; T[t++]=55; T[t++]=95;
-			R[r++]= 5; R[r++]= 3; R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 8; R[r++]= 2; R[r++]= 9; R[r++]= 7; R[r++]= 4; 		T[t++]=55; T[t++]=31; T[t++]=98; T[t++]=79; T[t++]=12; T[t++]=66; T[t++]=42; T[t++]=77; T[t++]=77; T[t++]=39;
-			R[r++]= 4; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; R[r++]= 1; R[r++]= 6; 		T[t++]=34; T[t++]=64; T[t++]=62; T[t++]=19; T[t++]=92; T[t++]=79; T[t++]=43; T[t++]=54; T[t++]=83; T[t++]=37;
-			R[r++]= 2; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 5; 		T[t++]=87; T[t++]=69; T[t++]=87; T[t++]=38; T[t++]=24; T[t++]=83; T[t++]=41; T[t++]=93; T[t++]=77; T[t++]=60;
-			R[r++]= 3; R[r++]= 1; R[r++]= 6; R[r++]= 7; R[r++]= 8; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 4; R[r++]= 9; 		T[t++]=98; T[t++]=44; T[t++]=25; T[t++]=75; T[t++]=43; T[t++]=49; T[t++]=96; T[t++]=77; T[t++]=17; T[t++]=79;
-			R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 9; R[r++]= 2; R[r++]= 8; 		T[t++]=35; T[t++]=76; T[t++]=28; T[t++]=10; T[t++]=61; T[t++]= 9; T[t++]=95; T[t++]=35; T[t++]= 7; T[t++]=95;
-			R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=16; T[t++]=59; T[t++]=46; T[t++]=91; T[t++]=43; T[t++]=50; T[t++]=52; T[t++]=59; T[t++]=28; T[t++]=27;
-			R[r++]= 2; R[r++]= 1; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 3; R[r++]= 8; 		T[t++]=45; T[t++]=87; T[t++]=41; T[t++]=20; T[t++]=54; T[t++]=43; T[t++]=14; T[t++]= 9; T[t++]=39; T[t++]=71;
-			R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 1; 		T[t++]=33; T[t++]=37; T[t++]=66; T[t++]=33; T[t++]=26; T[t++]= 8; T[t++]=28; T[t++]=89; T[t++]=42; T[t++]=78;
-			R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; R[r++]= 4; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 2; R[r++]= 6; 		T[t++]=69; T[t++]=81; T[t++]=94; T[t++]=96; T[t++]=27; T[t++]=69; T[t++]=45; T[t++]=78; T[t++]=74; T[t++]=84;
-
-        } else if(intProblema == 17) {
-            intMakeSpanOtimo = 784;
-
-			R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 8; R[r++]= 3; R[r++]= 1; R[r++]= 5; R[r++]= 4; R[r++]= 6; 		T[t++]=21; T[t++]=71; T[t++]=16; T[t++]=52; T[t++]=26; T[t++]=34; T[t++]=53; T[t++]=21; T[t++]=55; T[t++]=95;
-			R[r++]= 5; R[r++]= 3; R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 8; R[r++]= 2; R[r++]= 9; R[r++]= 7; R[r++]= 4; 		T[t++]=55; T[t++]=31; T[t++]=98; T[t++]=79; T[t++]=12; T[t++]=66; T[t++]=42; T[t++]=77; T[t++]=77; T[t++]=39;
-			R[r++]= 4; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; R[r++]= 1; R[r++]= 6; 		T[t++]=34; T[t++]=64; T[t++]=62; T[t++]=19; T[t++]=92; T[t++]=79; T[t++]=43; T[t++]=54; T[t++]=83; T[t++]=37;
-			R[r++]= 2; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 5; 		T[t++]=87; T[t++]=69; T[t++]=87; T[t++]=38; T[t++]=24; T[t++]=83; T[t++]=41; T[t++]=93; T[t++]=77; T[t++]=60;
-			R[r++]= 3; R[r++]= 1; R[r++]= 6; R[r++]= 7; R[r++]= 8; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 4; R[r++]= 9; 		T[t++]=98; T[t++]=44; T[t++]=25; T[t++]=75; T[t++]=43; T[t++]=49; T[t++]=96; T[t++]=77; T[t++]=17; T[t++]=79;
-			R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 9; R[r++]= 2; R[r++]= 8; 		T[t++]=35; T[t++]=76; T[t++]=28; T[t++]=10; T[t++]=61; T[t++]= 9; T[t++]=95; T[t++]=35; T[t++]= 7; T[t++]=95;
-			R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=16; T[t++]=59; T[t++]=46; T[t++]=91; T[t++]=43; T[t++]=50; T[t++]=52; T[t++]=59; T[t++]=28; T[t++]=27;
-			R[r++]= 2; R[r++]= 1; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 3; R[r++]= 8; 		T[t++]=45; T[t++]=87; T[t++]=41; T[t++]=20; T[t++]=54; T[t++]=43; T[t++]=14; T[t++]= 9; T[t++]=39; T[t++]=71;
-			R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 1; 		T[t++]=33; T[t++]=37; T[t++]=66; T[t++]=33; T[t++]=26; T[t++]= 8; T[t++]=28; T[t++]=89; T[t++]=42; T[t++]=78;
-			R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; R[r++]= 4; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 2; R[r++]= 6; 		T[t++]=69; T[t++]=81; T[t++]=94; T[t++]=96; T[t++]=27; T[t++]=69; T[t++]=45; T[t++]=78; T[t++]=74; T[t++]=84;
+        pLote.vetSementes.swap(vetNovo);
+        pLote.vetMakespans.resize(intNova);
+        pLote.intCapacidade = intNova;
+    }
 
-        } else if(intProblema ==18) {
-            intMakeSpanOtimo = 848;
+    for(int i = 0; i < intTamanho; i++){
+        pLote.vetSementes[i*pLote.intCapacidade + pLote.intQuantidade] = pSemente[i];
+    }
+    pLote.intQuantidade++;
+
+} // void loteAdiciona(LoteSementes &pLote, const vector<int> &pSemente){
+
+// Dados de uma chamada de poolRun() em loteAvalia(): cada tarefa avalia um
+// bloco contiguo de colunas do lote
+struct TarefaLote {
+    LoteSementes *pLote;
+    int intLimite;
+    int intTarefas;
+    vector<int> vetAbaixo;               // retorno de evaluateBatch() de cada tarefa
+    vector<unsigned long> vetCacheHits;   // consultas ao cache de cada tarefa,
+    vector<unsigned long> vetCacheMisses; // somadas depois no contexto principal
+};
+
+// Tarefa do pool: avalia as colunas do bloco intTarefa com o contexto da
+// thread. As colunas ficam no mesmo lugar do lote, entao o resultado e o
+// mesmo da avaliacao serial.
+void avaliaLotePool(int intTarefa, int intThread, void *pDados)
+{
+    TarefaLote &tarefa = *(TarefaLote *) pDados;
+    LoteSementes &lote = *tarefa.pLote;
+    int intInicio = (int) ((long) lote.intQuantidade * intTarefa / tarefa.intTarefas);
+    int intFim = (int) ((long) lote.intQuantidade * (intTarefa + 1) / tarefa.intTarefas);
+    unsigned long iHits, iMisses;
+
+    preparaThreadAvaliacao();
+    iHits = ctxAvaliacao.iCacheHits;
+    iMisses = ctxAvaliacao.iCacheMisses;
+
+    tarefa.vetAbaixo[intTarefa] = evaluateBatch(&ctxAvaliacao, &lote.vetSementes[intInicio],
+                                                lote.intCapacidade, intFim - intInicio,
+                                                tarefa.intLimite, &lote.vetMakespans[intInicio]);
+
+    tarefa.vetCacheHits[intTarefa] = ctxAvaliacao.iCacheHits - iHits;
+    tarefa.vetCacheMisses[intTarefa] = ctxAvaliacao.iCacheMisses - iMisses;
+} // void avaliaLotePool(int intTarefa, int intThread, void *pDados)
+
+// Avalia todas as candidatas do lote em vetMakespans (como avaliaSementeLimite).
+// Devolve quantas ficaram abaixo de intLimite.
+//   Na thread principal, com o pool ativo e um lote grande, as colunas sao
+// divididas entre as threads do pool. Quem percorre vetMakespans depois
+// (melhor melhoria, na ordem das candidatas) ve os mesmos valores. Isso so
+// acontece com a opcao -tv: com -t o pool ja avalia a populacao e as buscas
+// locais rodam nas threads dele, onde o lote fica serial (poolRun() nao
+// pode ser chamado de dentro de uma tarefa).
+int loteAvalia(LoteSementes &pLote, int intLimite){
+
+    if(pLote.intQuantidade == 0){
+        return 0;
+    }
 
-			R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 8; R[r++]= 3; R[r++]= 1; R[r++]= 5; R[r++]= 4; R[r++]= 6; 		T[t++]=21; T[t++]=71; T[t++]=16; T[t++]=52; T[t++]=26; T[t++]=34; T[t++]=53; T[t++]=21; T[t++]=55; T[t++]=95;
-			R[r++]= 5; R[r++]= 3; R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 8; R[r++]= 2; R[r++]= 9; R[r++]= 7; R[r++]= 4; 		T[t++]=55; T[t++]=31; T[t++]=98; T[t++]=79; T[t++]=12; T[t++]=66; T[t++]=42; T[t++]=77; T[t++]=77; T[t++]=39;
-			R[r++]= 4; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; R[r++]= 1; R[r++]= 6; 		T[t++]=34; T[t++]=64; T[t++]=62; T[t++]=19; T[t++]=92; T[t++]=79; T[t++]=43; T[t++]=54; T[t++]=83; T[t++]=37;
-			R[r++]= 2; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 5; 		T[t++]=87; T[t++]=69; T[t++]=87; T[t++]=38; T[t++]=24; T[t++]=83; T[t++]=41; T[t++]=93; T[t++]=77; T[t++]=60;
-			R[r++]= 3; R[r++]= 1; R[r++]= 6; R[r++]= 7; R[r++]= 8; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 4; R[r++]= 9; 		T[t++]=98; T[t++]=44; T[t++]=25; T[t++]=75; T[t++]=43; T[t++]=49; T[t++]=96; T[t++]=77; T[t++]=17; T[t++]=79;
-			R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 9; R[r++]= 2; R[r++]= 8; 		T[t++]=35; T[t++]=76; T[t++]=28; T[t++]=10; T[t++]=61; T[t++]= 9; T[t++]=95; T[t++]=35; T[t++]= 7; T[t++]=95;
-			R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=16; T[t++]=59; T[t++]=46; T[t++]=91; T[t++]=43; T[t++]=50; T[t++]=52; T[t++]=59; T[t++]=28; T[t++]=27;
-			R[r++]= 2; R[r++]= 1; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 3; R[r++]= 8; 		T[t++]=45; T[t++]=87; T[t++]=41; T[t++]=20; T[t++]=54; T[t++]=43; T[t++]=14; T[t++]= 9; T[t++]=39; T[t++]=71;
-			R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 1; 		T[t++]=33; T[t++]=37; T[t++]=66; T[t++]=33; T[t++]=26; T[t++]= 8; T[t++]=28; T[t++]=89; T[t++]=42; T[t++]=78;
-			R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; R[r++]= 4; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 2; R[r++]= 6; 		T[t++]=69; T[t++]=81; T[t++]=94; T[t++]=96; T[t++]=27; T[t++]=69; T[t++]=45; T[t++]=78; T[t++]=74; T[t++]=84;
+    if(threadAuxiliar || poolWorkers() < 2 ||
+       (long) pLote.intQuantidade * MACHINE * JOB < LOTEMINIMOPOOL){
+        return evaluateBatch(&ctxAvaliacao, &pLote.vetSementes[0], pLote.intCapacidade,
+                             pLote.intQuantidade, intLimite, &pLote.vetMakespans[0]);
+    }
 
-        } else if(intProblema ==19) {
-            intMakeSpanOtimo = 842;
+    TarefaLote tarefa;
+    int intAbaixo = 0;
 
-			R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 8; R[r++]= 3; R[r++]= 1; R[r++]= 5; R[r++]= 4; R[r++]= 6; 		T[t++]=21; T[t++]=71; T[t++]=16; T[t++]=52; T[t++]=26; T[t++]=34; T[t++]=53; T[t++]=21; T[t++]=55; T[t++]=95;
-			R[r++]= 5; R[r++]= 3; R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 8; R[r++]= 2; R[r++]= 9; R[r++]= 7; R[r++]= 4; 		T[t++]=55; T[t++]=31; T[t++]=98; T[t++]=79; T[t++]=12; T[t++]=66; T[t++]=42; T[t++]=77; T[t++]=77; T[t++]=39;
-			R[r++]= 4; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; R[r++]= 1; R[r++]= 6; 		T[t++]=34; T[t++]=64; T[t++]=62; T[t++]=19; T[t++]=92; T[t++]=79; T[t++]=43; T[t++]=54; T[t++]=83; T[t++]=37;
-			R[r++]= 2; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 5; 		T[t++]=87; T[t++]=69; T[t++]=87; T[t++]=38; T[t++]=24; T[t++]=83; T[t++]=41; T[t++]=93; T[t++]=77; T[t++]=60;
-			R[r++]= 3; R[r++]= 1; R[r++]= 6; R[r++]= 7; R[r++]= 8; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 4; R[r++]= 9; 		T[t++]=98; T[t++]=44; T[t++]=25; T[t++]=75; T[t++]=43; T[t++]=49; T[t++]=96; T[t++]=77; T[t++]=17; T[t++]=79;
-			R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 9; R[r++]= 2; R[r++]= 8; 		T[t++]=35; T[t++]=76; T[t++]=28; T[t++]=10; T[t++]=61; T[t++]= 9; T[t++]=95; T[t++]=35; T[t++]= 7; T[t++]=95;
-			R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=16; T[t++]=59; T[t++]=46; T[t++]=91; T[t++]=43; T[t++]=50; T[t++]=52; T[t++]=59; T[t++]=28; T[t++]=27;
-			R[r++]= 2; R[r++]= 1; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 3; R[r++]= 8; 		T[t++]=45; T[t++]=87; T[t++]=41; T[t++]=20; T[t++]=54; T[t++]=43; T[t++]=14; T[t++]= 9; T[t++]=39; T[t++]=71;
-			R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 1; 		T[t++]=33; T[t++]=37; T[t++]=66; T[t++]=33; T[t++]=26; T[t++]= 8; T[t++]=28; T[t++]=89; T[t++]=42; T[t++]=78;
-			R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; R[r++]= 4; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 2; R[r++]= 6; 		T[t++]=69; T[t++]=81; T[t++]=94; T[t++]=96; T[t++]=27; T[t++]=69; T[t++]=45; T[t++]=78; T[t++]=74; T[t++]=84;
+    tarefa.pLote = &pLote;
+    tarefa.intLimite = intLimite;
+    tarefa.intTarefas = min(poolWorkers(), pLote.intQuantidade);
+    tarefa.vetAbaixo.assign(tarefa.intTarefas, 0);
+    tarefa.vetCacheHits.assign(tarefa.intTarefas, 0);
+    tarefa.vetCacheMisses.assign(tarefa.intTarefas, 0);
 
-        } else if(intProblema ==20) {
-            intMakeSpanOtimo = 902;
+    poolRun(tarefa.intTarefas, avaliaLotePool, &tarefa);
 
-			R[r++]= 7; R[r++]= 2; R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 4; R[r++]= 1; R[r++]= 6; R[r++]=10; R[r++]= 8; 		T[t++]= 9; T[t++]=81; T[t++]=55; T[t++]=40; T[t++]=32; T[t++]=37; T[t++]= 6; T[t++]=19; T[t++]=81; T[t++]=40;
-			R[r++]= 8; R[r++]= 3; R[r++]=10; R[r++]= 5; R[r++]= 2; R[r++]= 6; R[r++]= 9; R[r++]= 1; R[r++]= 4; R[r++]= 7; 		T[t++]=21; T[t++]=70; T[t++]=65; T[t++]=64; T[t++]=46; T[t++]=65; T[t++]=25; T[t++]=77; T[t++]=55; T[t++]=15;
-			R[r++]= 3; R[r++]= 6; R[r++]= 1; R[r++]= 4; R[r++]= 2; R[r++]= 7; R[r++]= 5; R[r++]= 9; R[r++]= 8; R[r++]=10; 		T[t++]=85; T[t++]=37; T[t++]=40; T[t++]=24; T[t++]=44; T[t++]=83; T[t++]=89; T[t++]=31; T[t++]=84; T[t++]=29;
-			R[r++]= 5; R[r++]= 7; R[r++]= 8; R[r++]= 1; R[r++]= 3; R[r++]= 6; R[r++]= 4; R[r++]= 2; R[r++]=10; R[r++]= 9; 		T[t++]=80; T[t++]=77; T[t++]=56; T[t++]= 8; T[t++]=30; T[t++]=59; T[t++]=38; T[t++]=80; T[t++]=41; T[t++]=97;
-			R[r++]= 1; R[r++]= 7; R[r++]= 5; R[r++]= 2; R[r++]= 3; R[r++]= 4; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 8; 		T[t++]=91; T[t++]=40; T[t++]=88; T[t++]=17; T[t++]=71; T[t++]=50; T[t++]=59; T[t++]=80; T[t++]=56; T[t++]= 7;
-			R[r++]= 3; R[r++]= 7; R[r++]= 4; R[r++]= 6; R[r++]= 2; R[r++]= 9; R[r++]= 1; R[r++]=10; R[r++]= 5; R[r++]= 8; 		T[t++]= 8; T[t++]= 9; T[t++]=58; T[t++]=77; T[t++]=29; T[t++]=96; T[t++]=45; T[t++]=10; T[t++]=54; T[t++]=36;
-			R[r++]= 5; R[r++]= 4; R[r++]= 2; R[r++]= 6; R[r++]= 7; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 1; R[r++]= 3; 		T[t++]=70; T[t++]=92; T[t++]=98; T[t++]=87; T[t++]=99; T[t++]=27; T[t++]=86; T[t++]=96; T[t++]=28; T[t++]=73;
-			R[r++]= 2; R[r++]= 8; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 1; R[r++]= 3; R[r++]= 6; 		T[t++]=95; T[t++]=92; T[t++]=85; T[t++]=52; T[t++]=81; T[t++]=32; T[t++]=39; T[t++]=59; T[t++]=41; T[t++]=56;
-			R[r++]= 4; R[r++]= 9; R[r++]= 1; R[r++]= 3; R[r++]= 2; R[r++]= 6; R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; 		T[t++]=60; T[t++]=45; T[t++]=88; T[t++]=12; T[t++]= 7; T[t++]=22; T[t++]=93; T[t++]=49; T[t++]=69; T[t++]=27;
-			R[r++]= 1; R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 5; R[r++]= 8; R[r++]= 2; 		T[t++]=21; T[t++]=61; T[t++]=68; T[t++]=26; T[t++]=82; T[t++]=71; T[t++]=44; T[t++]=99; T[t++]=33; T[t++]=84;
+    for(int t = 0; t < tarefa.intTarefas; t++){
+        intAbaixo += tarefa.vetAbaixo[t];
+        ctxAvaliacao.iCacheHits += tarefa.vetCacheHits[t];
+        ctxAvaliacao.iCacheMisses += tarefa.vetCacheMisses[t];
+    }
 
-        } else {
-            printf( "Problema deve estar entre LA16 e LA20");
-            //getchar();
-            return 0; // 0 = erro
+    return intAbaixo;
 
-        }
+} // int loteAvalia(LoteSementes &pLote, int intLimite){
 
-    #endif
+// Copia a candidata intCandidata do lote para pSemente
+void loteSemente(const LoteSementes &pLote, int intCandidata, vector<int> &pSemente){
 
-    #ifdef PROGRAMA_21
-        if (intProblema == 21){
-            intMakeSpanOtimo = 1046;
+    pSemente.resize(MACHINE*JOB);
 
-			R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 9; R[r++]= 2; R[r++]= 8; 		T[t++]=34; T[t++]=55; T[t++]=95; T[t++]=16; T[t++]=21; T[t++]=71; T[t++]=53; T[t++]=52; T[t++]=21; T[t++]=26;
-			R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=39; T[t++]=31; T[t++]=12; T[t++]=42; T[t++]=79; T[t++]=77; T[t++]=77; T[t++]=98; T[t++]=55; T[t++]=66;
-			R[r++]= 2; R[r++]= 1; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 3; R[r++]= 8; 		T[t++]=19; T[t++]=83; T[t++]=34; T[t++]=92; T[t++]=54; T[t++]=79; T[t++]=62; T[t++]=37; T[t++]=64; T[t++]=43;
-			R[r++]= 5; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 7; R[r++]=10; R[r++]= 1; 		T[t++]=60; T[t++]=87; T[t++]=24; T[t++]=77; T[t++]=69; T[t++]=38; T[t++]=87; T[t++]=41; T[t++]=83; T[t++]=93;
-			R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; R[r++]= 4; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 2; R[r++]= 6; 		T[t++]=79; T[t++]=77; T[t++]=98; T[t++]=96; T[t++]=17; T[t++]=44; T[t++]=43; T[t++]=75; T[t++]=49; T[t++]=25;
-			R[r++]= 9; R[r++]= 8; R[r++]= 7; R[r++]=10; R[r++]= 3; R[r++]= 2; R[r++]= 6; R[r++]= 5; R[r++]= 1; R[r++]= 4; 		T[t++]=35; T[t++]=95; T[t++]= 9; T[t++]=10; T[t++]=35; T[t++]= 7; T[t++]=28; T[t++]=61; T[t++]=95; T[t++]=76;
-			R[r++]= 5; R[r++]= 6; R[r++]= 4; R[r++]=10; R[r++]= 1; R[r++]= 9; R[r++]= 7; R[r++]= 8; R[r++]= 3; R[r++]= 2; 		T[t++]=28; T[t++]=59; T[t++]=16; T[t++]=43; T[t++]=46; T[t++]=50; T[t++]=52; T[t++]=27; T[t++]=59; T[t++]=91;
-			R[r++]= 6; R[r++]= 5; R[r++]= 3; R[r++]= 7; R[r++]= 2; R[r++]= 8; R[r++]= 1; R[r++]= 4; R[r++]=10; R[r++]= 9; 		T[t++]= 9; T[t++]=20; T[t++]=39; T[t++]=54; T[t++]=45; T[t++]=71; T[t++]=87; T[t++]=41; T[t++]=43; T[t++]=14;
-			R[r++]= 2; R[r++]= 6; R[r++]= 1; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]= 7; R[r++]=10; R[r++]= 5; 		T[t++]=28; T[t++]=33; T[t++]=78; T[t++]=26; T[t++]=37; T[t++]= 8; T[t++]=66; T[t++]=89; T[t++]=42; T[t++]=33;
-			R[r++]= 3; R[r++]= 6; R[r++]= 7; R[r++]=10; R[r++]= 2; R[r++]= 4; R[r++]= 9; R[r++]= 1; R[r++]= 8; R[r++]= 5; 		T[t++]=94; T[t++]=84; T[t++]=78; T[t++]=81; T[t++]=74; T[t++]=27; T[t++]=69; T[t++]=69; T[t++]=45; T[t++]=96;
-			R[r++]= 2; R[r++]= 5; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 8; R[r++]= 7; 		T[t++]=31; T[t++]=24; T[t++]=20; T[t++]=17; T[t++]=25; T[t++]=81; T[t++]=76; T[t++]=87; T[t++]=32; T[t++]=18;
-			R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 5; R[r++]= 7; R[r++]= 4; R[r++]= 3; R[r++]= 2; R[r++]= 9; R[r++]= 8; 		T[t++]=28; T[t++]=97; T[t++]=58; T[t++]=45; T[t++]=76; T[t++]=99; T[t++]=23; T[t++]=72; T[t++]=90; T[t++]=86;
-			R[r++]= 6; R[r++]=10; R[r++]= 9; R[r++]= 8; R[r++]= 5; R[r++]= 7; R[r++]= 4; R[r++]= 1; R[r++]= 2; R[r++]= 3; 		T[t++]=27; T[t++]=48; T[t++]=27; T[t++]=62; T[t++]=98; T[t++]=67; T[t++]=48; T[t++]=42; T[t++]=46; T[t++]=17;
-			R[r++]= 2; R[r++]= 9; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 4; R[r++]= 6; R[r++]= 7; R[r++]= 5; R[r++]= 8; 		T[t++]=12; T[t++]=50; T[t++]=80; T[t++]=50; T[t++]=80; T[t++]=19; T[t++]=28; T[t++]=63; T[t++]=94; T[t++]=98;
-			R[r++]= 5; R[r++]= 4; R[r++]= 7; R[r++]= 6; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]=10; R[r++]= 8; R[r++]= 1; 		T[t++]=61; T[t++]=55; T[t++]=37; T[t++]=14; T[t++]=50; T[t++]=79; T[t++]=41; T[t++]=72; T[t++]=18; T[t++]=75;
+    for(int i = 0; i < MACHINE*JOB; i++){
+        pSemente[i] = pLote.vetSementes[i*pLote.intCapacidade + intCandidata];
+    }
 
-        } else if(intProblema == 22) {
-            intMakeSpanOtimo = 927;
+} // void loteSemente(const LoteSementes &pLote, int intCandidata, vector<int> &pSemente){
 
-			R[r++]=10; R[r++]= 6; R[r++]= 5; R[r++]= 3; R[r++]= 8; R[r++]= 4; R[r++]= 2; R[r++]= 1; R[r++]= 9; R[r++]= 7; 		T[t++]=66; T[t++]=91; T[t++]=87; T[t++]=94; T[t++]=21; T[t++]=92; T[t++]= 7; T[t++]=12; T[t++]=11; T[t++]=19;
-			R[r++]= 4; R[r++]= 3; R[r++]= 5; R[r++]= 2; R[r++]=10; R[r++]= 1; R[r++]= 7; R[r++]= 6; R[r++]= 8; R[r++]= 9; 		T[t++]=13; T[t++]=20; T[t++]= 7; T[t++]=14; T[t++]=66; T[t++]=75; T[t++]=77; T[t++]=16; T[t++]=95; T[t++]= 7;
-			R[r++]= 9; R[r++]= 8; R[r++]= 3; R[r++]= 1; R[r++]=10; R[r++]= 6; R[r++]= 7; R[r++]= 4; R[r++]= 2; R[r++]= 5; 		T[t++]=77; T[t++]=20; T[t++]=34; T[t++]=15; T[t++]=88; T[t++]=89; T[t++]=53; T[t++]= 6; T[t++]=45; T[t++]=76;
-			R[r++]= 4; R[r++]= 3; R[r++]= 7; R[r++]= 5; R[r++]= 8; R[r++]= 9; R[r++]= 6; R[r++]=10; R[r++]= 1; R[r++]= 2; 		T[t++]=27; T[t++]=74; T[t++]=88; T[t++]=62; T[t++]=52; T[t++]=69; T[t++]= 9; T[t++]=98; T[t++]=52; T[t++]=88;
-			R[r++]= 5; R[r++]= 7; R[r++]= 2; R[r++]= 3; R[r++]= 8; R[r++]= 1; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]=10; 		T[t++]=88; T[t++]=15; T[t++]=52; T[t++]=61; T[t++]=54; T[t++]=62; T[t++]=59; T[t++]= 9; T[t++]=90; T[t++]= 5;
-			R[r++]= 7; R[r++]= 1; R[r++]= 5; R[r++]= 4; R[r++]= 8; R[r++]= 9; R[r++]= 2; R[r++]= 6; R[r++]= 3; R[r++]=10; 		T[t++]=71; T[t++]=41; T[t++]=38; T[t++]=53; T[t++]=91; T[t++]=68; T[t++]=50; T[t++]=78; T[t++]=23; T[t++]=72;
-			R[r++]= 4; R[r++]=10; R[r++]= 7; R[r++]= 6; R[r++]= 1; R[r++]= 9; R[r++]= 5; R[r++]= 3; R[r++]= 8; R[r++]= 2; 		T[t++]=95; T[t++]=36; T[t++]=66; T[t++]=52; T[t++]=45; T[t++]=30; T[t++]=23; T[t++]=25; T[t++]=17; T[t++]= 6;
-			R[r++]= 5; R[r++]= 2; R[r++]= 9; R[r++]= 1; R[r++]= 8; R[r++]= 7; R[r++]= 6; R[r++]= 4; R[r++]=10; R[r++]= 3; 		T[t++]=65; T[t++]= 8; T[t++]=85; T[t++]=71; T[t++]=65; T[t++]=28; T[t++]=88; T[t++]=76; T[t++]=27; T[t++]=95;
-			R[r++]=10; R[r++]= 2; R[r++]= 5; R[r++]= 4; R[r++]= 9; R[r++]= 3; R[r++]= 7; R[r++]= 1; R[r++]= 8; R[r++]= 6; 		T[t++]=37; T[t++]=37; T[t++]=28; T[t++]=51; T[t++]=86; T[t++]= 9; T[t++]=55; T[t++]=73; T[t++]=51; T[t++]=90;
-			R[r++]= 4; R[r++]= 3; R[r++]= 7; R[r++]=10; R[r++]= 8; R[r++]= 1; R[r++]= 5; R[r++]= 6; R[r++]= 2; R[r++]= 9; 		T[t++]=39; T[t++]=15; T[t++]=83; T[t++]=44; T[t++]=53; T[t++]=16; T[t++]=46; T[t++]=24; T[t++]=25; T[t++]=82;
-			R[r++]= 2; R[r++]= 5; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 7; R[r++]= 8; R[r++]= 9; R[r++]= 6; R[r++]= 4; 		T[t++]=72; T[t++]=48; T[t++]=87; T[t++]=66; T[t++]= 5; T[t++]=54; T[t++]=39; T[t++]=35; T[t++]=95; T[t++]=60;
-			R[r++]= 2; R[r++]= 4; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 8; R[r++]= 9; R[r++]= 5; R[r++]= 7; R[r++]= 6; 		T[t++]=46; T[t++]=20; T[t++]=97; T[t++]=21; T[t++]=46; T[t++]=37; T[t++]=19; T[t++]=59; T[t++]=34; T[t++]=55;
-			R[r++]= 6; R[r++]= 4; R[r++]= 7; R[r++]= 2; R[r++]= 1; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 3; R[r++]= 5; 		T[t++]=23; T[t++]=25; T[t++]=78; T[t++]=24; T[t++]=28; T[t++]=83; T[t++]=28; T[t++]= 5; T[t++]=73; T[t++]=45;
-			R[r++]= 2; R[r++]= 1; R[r++]= 8; R[r++]= 5; R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 3; 		T[t++]=37; T[t++]=53; T[t++]=87; T[t++]=38; T[t++]=71; T[t++]=29; T[t++]=12; T[t++]=33; T[t++]=55; T[t++]=12;
-			R[r++]= 5; R[r++]= 9; R[r++]= 3; R[r++]= 4; R[r++]= 2; R[r++]= 7; R[r++]= 8; R[r++]=10; R[r++]= 6; R[r++]= 1; 		T[t++]=90; T[t++]=17; T[t++]=49; T[t++]=83; T[t++]=40; T[t++]=23; T[t++]=65; T[t++]=27; T[t++]= 7; T[t++]=48;
+int SetProblem( int argc, char **argv ){
+    string strProblema;
+    string strInstancia = "2";
 
-        } else if(intProblema ==23) {
-            intMakeSpanOtimo = 1032;
+    // 1o parametro indica a abordagem a ser explorada
+    if (argc > 1) {
+        intAbordagem = atoi(argv[1]);
+    } else {
+        intAbordagem = 2; // 1=No Factvel; 2=FIFO; 3=FIFO + SPT; 4=FIFO + LPT; 5=NEH
+    }
 
-			R[r++]= 8; R[r++]= 6; R[r++]= 9; R[r++]= 3; R[r++]= 5; R[r++]= 7; R[r++]= 4; R[r++]= 2; R[r++]=10; R[r++]= 1; 		T[t++]=84; T[t++]=58; T[t++]=77; T[t++]=44; T[t++]=97; T[t++]=89; T[t++]= 5; T[t++]=58; T[t++]=96; T[t++]= 9;
-			R[r++]= 7; R[r++]= 2; R[r++]= 5; R[r++]= 6; R[r++]= 3; R[r++]= 4; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 1; 		T[t++]=21; T[t++]=87; T[t++]=15; T[t++]=39; T[t++]=81; T[t++]=85; T[t++]=31; T[t++]=57; T[t++]=73; T[t++]=77;
-			R[r++]= 1; R[r++]= 6; R[r++]= 9; R[r++]=10; R[r++]= 4; R[r++]= 7; R[r++]= 5; R[r++]= 8; R[r++]= 3; R[r++]= 2; 		T[t++]=40; T[t++]=71; T[t++]=34; T[t++]=82; T[t++]=70; T[t++]=22; T[t++]=10; T[t++]=80; T[t++]=48; T[t++]=49;
-			R[r++]= 6; R[r++]= 3; R[r++]= 4; R[r++]= 7; R[r++]= 5; R[r++]= 8; R[r++]= 9; R[r++]=10; R[r++]= 2; R[r++]= 1; 		T[t++]=75; T[t++]=17; T[t++]= 7; T[t++]=72; T[t++]=11; T[t++]=62; T[t++]=47; T[t++]=35; T[t++]=91; T[t++]=55;
-			R[r++]=10; R[r++]= 5; R[r++]= 7; R[r++]= 8; R[r++]= 1; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 4; R[r++]= 2; 		T[t++]=20; T[t++]=12; T[t++]=71; T[t++]=67; T[t++]=64; T[t++]=94; T[t++]=15; T[t++]=50; T[t++]=75; T[t++]=90;
-			R[r++]= 7; R[r++]= 6; R[r++]= 2; R[r++]= 8; R[r++]= 9; R[r++]= 5; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 4; 		T[t++]=93; T[t++]=93; T[t++]=57; T[t++]=70; T[t++]=77; T[t++]=58; T[t++]=52; T[t++]=29; T[t++]= 7; T[t++]=68;
-			R[r++]= 8; R[r++]= 1; R[r++]= 9; R[r++]= 5; R[r++]= 3; R[r++]= 2; R[r++]=10; R[r++]= 4; R[r++]= 7; R[r++]= 6; 		T[t++]=56; T[t++]=95; T[t++]=48; T[t++]=26; T[t++]=82; T[t++]=63; T[t++]=36; T[t++]=27; T[t++]=87; T[t++]= 6;
-			R[r++]= 4; R[r++]= 6; R[r++]=10; R[r++]= 2; R[r++]= 9; R[r++]= 3; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 8; 		T[t++]=76; T[t++]=15; T[t++]=78; T[t++]= 8; T[t++]=41; T[t++]=36; T[t++]=30; T[t++]=84; T[t++]=36; T[t++]=76;
-			R[r++]= 1; R[r++]= 8; R[r++]= 3; R[r++]= 9; R[r++]= 5; R[r++]= 7; R[r++]= 6; R[r++]= 2; R[r++]=10; R[r++]= 4; 		T[t++]=75; T[t++]=13; T[t++]=81; T[t++]=29; T[t++]=54; T[t++]=82; T[t++]=88; T[t++]=78; T[t++]=40; T[t++]=13;
-			R[r++]= 3; R[r++]= 2; R[r++]= 8; R[r++]= 7; R[r++]= 5; R[r++]= 1; R[r++]= 6; R[r++]= 4; R[r++]=10; R[r++]= 9; 		T[t++]= 6; T[t++]=26; T[t++]=32; T[t++]=64; T[t++]=54; T[t++]=52; T[t++]=82; T[t++]= 6; T[t++]=88; T[t++]=54;
-			R[r++]= 9; R[r++]= 3; R[r++]= 6; R[r++]= 1; R[r++]= 8; R[r++]= 4; R[r++]= 2; R[r++]= 5; R[r++]=10; R[r++]= 7; 		T[t++]=62; T[t++]=67; T[t++]=32; T[t++]=62; T[t++]=69; T[t++]=61; T[t++]=35; T[t++]=72; T[t++]= 5; T[t++]=93;
-			R[r++]= 3; R[r++]=10; R[r++]= 1; R[r++]= 2; R[r++]= 9; R[r++]= 7; R[r++]= 4; R[r++]= 8; R[r++]= 6; R[r++]= 5; 		T[t++]=78; T[t++]=90; T[t++]=85; T[t++]=72; T[t++]=64; T[t++]=63; T[t++]=11; T[t++]=82; T[t++]=88; T[t++]= 7;
-			R[r++]= 5; R[r++]=10; R[r++]= 8; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 3; R[r++]= 2; R[r++]= 9; R[r++]= 4; 		T[t++]=28; T[t++]=11; T[t++]=50; T[t++]=88; T[t++]=44; T[t++]=31; T[t++]=27; T[t++]=66; T[t++]=49; T[t++]=35;
-			R[r++]= 3; R[r++]= 6; R[r++]= 7; R[r++]= 5; R[r++]= 4; R[r++]=10; R[r++]= 8; R[r++]= 2; R[r++]= 9; R[r++]= 1; 		T[t++]=14; T[t++]=39; T[t++]=56; T[t++]=62; T[t++]=97; T[t++]=66; T[t++]=69; T[t++]= 7; T[t++]=47; T[t++]=76;
-			R[r++]= 2; R[r++]= 9; R[r++]= 8; R[r++]= 7; R[r++]= 4; R[r++]=10; R[r++]= 3; R[r++]= 6; R[r++]= 5; R[r++]= 1; 		T[t++]=18; T[t++]=93; T[t++]=58; T[t++]=47; T[t++]=69; T[t++]=57; T[t++]=41; T[t++]=53; T[t++]=79; T[t++]=64;
+    // 2o parametro indica o problema LAxx
+    if (argc > 2) {
+        strProblema = argv[2];
+        intProblema = atoi(argv[2]);
 
-        } else if(intProblema ==24) {
-            intMakeSpanOtimo = 935;
+    } else {
+        intProblema = 1; // LA01
+        strProblema = "1";
+    }
 
-			R[r++]= 8; R[r++]=10; R[r++]= 1; R[r++]= 7; R[r++]= 5; R[r++]= 9; R[r++]= 3; R[r++]= 6; R[r++]= 2; R[r++]= 4; 		T[t++]= 8; T[t++]=75; T[t++]=72; T[t++]=74; T[t++]=30; T[t++]=43; T[t++]=38; T[t++]=98; T[t++]=26; T[t++]=19;
-			R[r++]= 7; R[r++]= 9; R[r++]= 4; R[r++]= 1; R[r++]= 2; R[r++]= 5; R[r++]= 6; R[r++]=10; R[r++]= 3; R[r++]= 8; 		T[t++]=19; T[t++]=73; T[t++]=43; T[t++]=23; T[t++]=85; T[t++]=39; T[t++]=13; T[t++]=26; T[t++]=67; T[t++]= 9;
-			R[r++]= 2; R[r++]= 4; R[r++]= 6; R[r++]= 5; R[r++]= 1; R[r++]= 3; R[r++]= 7; R[r++]= 9; R[r++]=10; R[r++]= 8; 		T[t++]=50; T[t++]=93; T[t++]=80; T[t++]= 7; T[t++]=55; T[t++]=61; T[t++]=57; T[t++]=72; T[t++]=42; T[t++]=46;
-			R[r++]= 2; R[r++]= 8; R[r++]= 5; R[r++]= 7; R[r++]= 6; R[r++]= 1; R[r++]= 9; R[r++]= 4; R[r++]=10; R[r++]= 3; 		T[t++]=68; T[t++]=43; T[t++]=99; T[t++]=60; T[t++]=68; T[t++]=91; T[t++]=11; T[t++]=96; T[t++]=11; T[t++]=72;
-			R[r++]= 8; R[r++]= 3; R[r++]= 9; R[r++]= 6; R[r++]= 2; R[r++]= 7; R[r++]= 4; R[r++]= 1; R[r++]=10; R[r++]= 5; 		T[t++]=84; T[t++]=34; T[t++]=40; T[t++]= 7; T[t++]=70; T[t++]=74; T[t++]=12; T[t++]=43; T[t++]=69; T[t++]=30;
-			R[r++]= 9; R[r++]= 1; R[r++]= 5; R[r++]= 6; R[r++]=10; R[r++]= 2; R[r++]= 8; R[r++]= 7; R[r++]= 4; R[r++]= 3; 		T[t++]=60; T[t++]=49; T[t++]=59; T[t++]=72; T[t++]=63; T[t++]=69; T[t++]=99; T[t++]=45; T[t++]=27; T[t++]= 9;
-			R[r++]= 7; R[r++]= 3; R[r++]= 9; R[r++]= 2; R[r++]=10; R[r++]= 5; R[r++]= 8; R[r++]= 1; R[r++]= 6; R[r++]= 4; 		T[t++]=71; T[t++]=91; T[t++]=65; T[t++]=90; T[t++]=98; T[t++]= 8; T[t++]=50; T[t++]=75; T[t++]=37; T[t++]=17;
-			R[r++]= 9; R[r++]= 8; R[r++]= 6; R[r++]= 4; R[r++]= 3; R[r++]= 5; R[r++]=10; R[r++]= 2; R[r++]= 1; R[r++]= 7; 		T[t++]=62; T[t++]=90; T[t++]=98; T[t++]=31; T[t++]=91; T[t++]=38; T[t++]=72; T[t++]= 9; T[t++]=72; T[t++]=49;
-			R[r++]= 5; R[r++]= 1; R[r++]=10; R[r++]= 6; R[r++]= 8; R[r++]= 4; R[r++]= 3; R[r++]= 9; R[r++]= 7; R[r++]= 2; 		T[t++]=35; T[t++]=39; T[t++]=74; T[t++]=25; T[t++]=47; T[t++]=52; T[t++]=63; T[t++]=21; T[t++]=35; T[t++]=80;
-			R[r++]=10; R[r++]= 1; R[r++]= 4; R[r++]= 9; R[r++]= 2; R[r++]= 7; R[r++]= 3; R[r++]= 6; R[r++]= 5; R[r++]= 8; 		T[t++]=58; T[t++]= 5; T[t++]=50; T[t++]=52; T[t++]=88; T[t++]=20; T[t++]=68; T[t++]=24; T[t++]=53; T[t++]=57;
-			R[r++]= 8; R[r++]= 4; R[r++]= 5; R[r++]= 6; R[r++]= 3; R[r++]= 7; R[r++]= 1; R[r++]=10; R[r++]= 2; R[r++]= 9; 		T[t++]=99; T[t++]=91; T[t++]=33; T[t++]=19; T[t++]=18; T[t++]=38; T[t++]=24; T[t++]=35; T[t++]=49; T[t++]= 9;
-			R[r++]= 1; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]= 9; R[r++]= 6; R[r++]=10; R[r++]= 2; R[r++]= 7; R[r++]= 5; 		T[t++]=68; T[t++]=60; T[t++]=77; T[t++]=10; T[t++]=60; T[t++]=15; T[t++]=72; T[t++]=18; T[t++]=90; T[t++]=18;
-			R[r++]=10; R[r++]= 2; R[r++]= 4; R[r++]= 7; R[r++]= 3; R[r++]= 9; R[r++]= 8; R[r++]= 1; R[r++]= 6; R[r++]= 5; 		T[t++]=79; T[t++]=60; T[t++]=56; T[t++]=91; T[t++]=40; T[t++]=86; T[t++]=72; T[t++]=80; T[t++]=89; T[t++]=51;
-			R[r++]= 5; R[r++]= 3; R[r++]= 6; R[r++]= 7; R[r++]= 9; R[r++]= 8; R[r++]= 4; R[r++]= 2; R[r++]= 1; R[r++]=10; 		T[t++]=10; T[t++]=92; T[t++]=23; T[t++]=46; T[t++]=40; T[t++]=72; T[t++]= 6; T[t++]=23; T[t++]=95; T[t++]=34;
-			R[r++]= 3; R[r++]= 6; R[r++]=10; R[r++]= 9; R[r++]= 1; R[r++]= 7; R[r++]= 4; R[r++]= 8; R[r++]= 2; R[r++]= 5; 		T[t++]=24; T[t++]=29; T[t++]=49; T[t++]=55; T[t++]=47; T[t++]=77; T[t++]=77; T[t++]= 8; T[t++]=28; T[t++]=48;
+    // 3o parametro indica a quantidade de iteraes
+    if (argc > 3) {
+        outIter = atoi(argv[3]);
+    }
 
-        } else if(intProblema ==25) {
-            intMakeSpanOtimo = 977;
+    if (argc > 4 ){
+        intInstancia = atoi(argv[4]);
+        strInstancia = argv[4];
+    }
 
-			R[r++]= 9; R[r++]= 5; R[r++]= 4; R[r++]= 3; R[r++]= 1; R[r++]= 6; R[r++]=10; R[r++]= 2; R[r++]= 8; R[r++]= 7; 		T[t++]=14; T[t++]=75; T[t++]=12; T[t++]=38; T[t++]=76; T[t++]=97; T[t++]=12; T[t++]=29; T[t++]=44; T[t++]=66;
-			R[r++]= 6; R[r++]= 4; R[r++]= 3; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 1; R[r++]= 2; R[r++]= 8; R[r++]= 9; 		T[t++]=38; T[t++]=82; T[t++]=85; T[t++]=58; T[t++]=87; T[t++]=89; T[t++]=43; T[t++]=80; T[t++]=69; T[t++]=92;
-			R[r++]=10; R[r++]= 2; R[r++]= 1; R[r++]= 7; R[r++]= 5; R[r++]= 8; R[r++]= 4; R[r++]= 6; R[r++]= 9; R[r++]= 3; 		T[t++]= 5; T[t++]=84; T[t++]=43; T[t++]=48; T[t++]= 8; T[t++]= 7; T[t++]=41; T[t++]=61; T[t++]=66; T[t++]=14;
-			R[r++]= 3; R[r++]= 2; R[r++]= 1; R[r++]= 6; R[r++]= 5; R[r++]= 8; R[r++]=10; R[r++]= 9; R[r++]= 4; R[r++]= 7; 		T[t++]=42; T[t++]= 8; T[t++]=96; T[t++]=19; T[t++]=59; T[t++]=97; T[t++]=73; T[t++]=43; T[t++]=74; T[t++]=41;
-			R[r++]= 7; R[r++]= 3; R[r++]= 4; R[r++]= 9; R[r++]= 5; R[r++]= 8; R[r++]= 2; R[r++]= 6; R[r++]=10; R[r++]= 1; 		T[t++]=55; T[t++]=70; T[t++]=75; T[t++]=42; T[t++]=37; T[t++]=23; T[t++]=48; T[t++]= 5; T[t++]=38; T[t++]= 7;
-			R[r++]= 9; R[r++]= 3; R[r++]= 8; R[r++]= 1; R[r++]= 6; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]=10; R[r++]= 2; 		T[t++]= 9; T[t++]=72; T[t++]=31; T[t++]=79; T[t++]=73; T[t++]=95; T[t++]=25; T[t++]=43; T[t++]=60; T[t++]=56;
-			R[r++]= 1; R[r++]= 3; R[r++]= 4; R[r++]= 6; R[r++]= 5; R[r++]=10; R[r++]= 9; R[r++]= 7; R[r++]= 8; R[r++]= 2; 		T[t++]=97; T[t++]=64; T[t++]=78; T[t++]=21; T[t++]=94; T[t++]=31; T[t++]=53; T[t++]=16; T[t++]=86; T[t++]= 7;
-			R[r++]= 4; R[r++]= 8; R[r++]=10; R[r++]= 1; R[r++]= 3; R[r++]= 5; R[r++]= 6; R[r++]= 2; R[r++]= 9; R[r++]= 7; 		T[t++]=86; T[t++]=85; T[t++]=63; T[t++]=61; T[t++]=65; T[t++]=30; T[t++]=32; T[t++]=33; T[t++]=44; T[t++]=59;
-			R[r++]= 3; R[r++]= 4; R[r++]= 5; R[r++]= 7; R[r++]= 2; R[r++]=10; R[r++]= 9; R[r++]= 1; R[r++]= 6; R[r++]= 8; 		T[t++]=44; T[t++]=16; T[t++]=11; T[t++]=45; T[t++]=30; T[t++]=84; T[t++]=93; T[t++]=60; T[t++]=61; T[t++]=90;
-			R[r++]= 8; R[r++]= 9; R[r++]= 5; R[r++]= 7; R[r++]= 1; R[r++]= 6; R[r++]= 3; R[r++]=10; R[r++]= 4; R[r++]= 2; 		T[t++]=36; T[t++]=31; T[t++]=47; T[t++]=52; T[t++]=32; T[t++]=11; T[t++]=28; T[t++]=35; T[t++]=20; T[t++]=49;
-			R[r++]= 9; R[r++]= 7; R[r++]= 8; R[r++]= 5; R[r++]= 6; R[r++]= 4; R[r++]= 1; R[r++]= 3; R[r++]=10; R[r++]= 2; 		T[t++]=20; T[t++]=49; T[t++]=74; T[t++]=10; T[t++]=17; T[t++]=34; T[t++]=85; T[t++]=77; T[t++]=68; T[t++]=84;
-			R[r++]= 2; R[r++]= 6; R[r++]= 9; R[r++]= 7; R[r++]= 5; R[r++]= 1; R[r++]= 4; R[r++]= 3; R[r++]= 8; R[r++]=10; 		T[t++]=85; T[t++]= 7; T[t++]=71; T[t++]=59; T[t++]=76; T[t++]=17; T[t++]=29; T[t++]=17; T[t++]=48; T[t++]=13;
-			R[r++]= 3; R[r++]= 7; R[r++]= 8; R[r++]= 2; R[r++]= 5; R[r++]= 9; R[r++]= 1; R[r++]= 4; R[r++]=10; R[r++]= 6; 		T[t++]=15; T[t++]=87; T[t++]=11; T[t++]=39; T[t++]=39; T[t++]=43; T[t++]=19; T[t++]=32; T[t++]=16; T[t++]=64;
-			R[r++]= 7; R[r++]= 3; R[r++]= 6; R[r++]= 9; R[r++]= 2; R[r++]= 8; R[r++]=10; R[r++]= 5; R[r++]= 4; R[r++]= 1; 		T[t++]=32; T[t++]=92; T[t++]=33; T[t++]=82; T[t++]=83; T[t++]=57; T[t++]=99; T[t++]=91; T[t++]=99; T[t++]= 8;
-			R[r++]= 5; R[r++]= 8; R[r++]= 9; R[r++]= 2; R[r++]= 4; R[r++]= 3; R[r++]= 7; R[r++]=10; R[r++]= 6; R[r++]= 1; 		T[t++]=88; T[t++]= 7; T[t++]=27; T[t++]=38; T[t++]=91; T[t++]=69; T[t++]=21; T[t++]=62; T[t++]=39; T[t++]=48;
 
-        } else {
-            printf( "Problema deve estar entre LA21 e LA25");
-            //getchar();
-            return 0; // 0 = erro
+    switch (intAbordagem) {
+    case 1:
+        strSemente = "Nao Factivel";
+        break;
+    case 2:
+        strSemente = "FIFO";
+        break;
+    case 3:
+        strSemente = "FIFO+SPT";
+        break;
+    case 4:
+        strSemente = "FIFO+LPT";
+        break;
+    case 5:
+        strSemente = "NEH_CP";
+        break;
+    }
 
-        }
+    Con="\\LA" + strProblema + "_Convergence_" + strSemente + "_" + strInstancia + ".txt";
+    His="\\LA" + strProblema + "_History.csv";
+    Bsi="\\LA" + strProblema + "_BestSequenceIdentified_" + strSemente + "_" + strInstancia + ".txt";
+    Sch="\\LA" + strProblema + "_Scheduling_" + strSemente + "_" + strInstancia + ".csv";
 
-    #endif
+    ArqHis = PastaDesktop + His;
+    ArqCon = PastaDesktop + Con;
+    ArqBsi = PastaDesktop + Bsi;
+    ArqSch = PastaDesktop + Sch;
 
-    return 1; // ' = sucesso
+    // Rotas, tempos e dimensoes da instancia
+    return SetProblema(intProblema);
 
 } // void SetProblem( int argc, char **argv ){
 
@@ -1243,8 +1141,142 @@ int main(int argc, char **argv)
     //    return 0;
     //}
 
-    SetProblema(1);
+    // DECODIFICADORES ESPECIALIZADOS PARA AS DIMENSOES DOS PROBLEMAS LA
+    registerFixedKernels();
+
+    // AVALIACAO DOS LOTES EM PISTAS SIMD (AVX2/AVX-512), SE A CPU SUPORTAR
+    registerSimdKernels();
+
+    // FILA DE PROBLEMAS LAxx A EXECUTAR, UM POR PARAMETRO (PADRAO: LA01)
+    vector<int> filaProblemas;
+
+    // THREADS PARA AVALIAR A POPULACAO (-t N, 0 = UMA POR NUCLEO); SEM -t A
+    // AVALIACAO E SERIAL. -tv N: N THREADS DIVIDEM OS LOTES DE VIZINHOS DAS
+    // BUSCAS LOCAIS, COM A POPULACAO AVALIADA EM SERIE. -d N: AG EM N ILHAS,
+    // UMA THREAD POR ILHA (A MIGRACAO E ASSINCRONA: COM -d A EXECUCAO NAO SE
+    // REPETE PARA O MESMO -s).
+    // -s N: NUMERO DA EXECUCAO, SEMENTE MESTRE DOS GERADORES ALEATORIOS.
+    // -tabu N: BUSCA TABU DE N ITERACOES NO LUGAR DA BUSCA LOCAL APOS O AG,
+    // -tabut S: COM NO MAXIMO S SEGUNDOS CADA. -permc: PERMUTACAO DE TODOS
+    // OS PARES DE CADA MAQUINA, SEM O FILTRO DO CAMINHO CRITICO. -opfixo:
+    // TODAS AS BUSCAS LOCAIS EM CADA SEMENTE, SEM A ESCOLHA ADAPTATIVA
+    int intThreads = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "-t" && i + 1 < argc) {
+            intThreads = atoi(argv[++i]);
+            bPoolVizinhanca = false;
+            continue;
+        }
+        if (string(argv[i]) == "-tv" && i + 1 < argc) {
+            intThreads = atoi(argv[++i]);
+            bPoolVizinhanca = true;
+            continue;
+        }
+        if (string(argv[i]) == "-d" && i + 1 < argc) {
+            intIlhas = max(atoi(argv[++i]), 0);
+            continue;
+        }
+        if (string(argv[i]) == "-s" && i + 1 < argc) {
+            intInstancia = atoi(argv[++i]);
+            continue;
+        }
+        if (string(argv[i]) == "-tabu" && i + 1 < argc) {
+            intTabuIteracoes = max(atoi(argv[++i]), 0);
+            continue;
+        }
+        if (string(argv[i]) == "-tabut" && i + 1 < argc) {
+            dblTabuSegundos = max(atof(argv[++i]), 0.0);
+            continue;
+        }
+        if (string(argv[i]) == "-permc") {
+            bPermutacaoCompleta = true;
+            continue;
+        }
+        if (string(argv[i]) == "-opfixo") {
+            bOperadoresFixos = true;
+            continue;
+        }
+        filaProblemas.push_back(atoi(argv[i]));
+    }
+
+    if (intThreads >= 0) {
+        cout << "Avaliacao paralela " << (bPoolVizinhanca ? "dos vizinhos" : "da populacao")
+             << " com " << poolStart(intThreads) << " threads" << endl;
+    }
+
+    if (filaProblemas.empty()) {
+        filaProblemas.push_back(1);
+    }
+
+    for (size_t p = 0; p < filaProblemas.size(); p++) {
+        intProblema = filaProblemas[p];
+
+        // DIMENSIONA A INSTANCIA; PROBLEMAS INVALIDOS SAO IGNORADOS
+        if (SetProblema(intProblema) == 0) {
+            cout << endl;
+            continue;
+        }
+
+        reiniciaEstado();
+        executaProblema();
+    }
+
+    poolStop();
+    evalFree(&ctxAvaliacao);
+
+    getchar();
+    return 0;
+} // Main
+
+/******************************************************************************
+* 	Function: reiniciaEstado												  *
+*	Short Description: Restores the global state of the search, so that each *
+*					   problem of the queue starts from scratch.			  *
+*******************************************************************************/
+void reiniciaEstado()
+{
+    score_ant = ITER;
+    bestCurrent = ITER;
+    seedIndexCurrent = 0;
+    primeira_geracao_s = true;
+    STOP = false;
+    cpBasedSeed = false;
+
+    bestScorePermutacao = 0;
+    bestScoreInsercao = 0;
+    bestScoreInsercaoCompleta = 0;
+    for (int k = 0; k < NOPERADORES; k++) {
+        vetOperadores[k] = EstatisticaOperador();
+    }
+    listaSolucaoPermutacao.assign(MACHINE*JOB, 0);
+    listaSolucaoInsercao.assign(MACHINE*JOB, 0);
+    listaSolucaoInsercaoCompleta.assign(MACHINE*JOB, 0);
+    bestSeedBuscaLocal.assign(MACHINE*JOB, 0);
+    seedFinal.assign(MACHINE*JOB, 0);
+    currentCriticalPath.clear();
+
+    S.assign(nBestIndividuals, vector<int>());
+    loteVizinhos.vetSementes.clear(); // dimensionado pela instancia
+    loteVizinhos.intCapacidade = 0;
+    loteVizinhos.intQuantidade = 0;
+    score_rodada_anterior.assign(nBestIndividuals, 0);
+    bestSeedsIndex.assign(nBestIndividuals, 0);
+    scoreTopList.assign(nBestIndividuals, 0);
+
+    intSolucoesFactiveis = 0;
+    intSolucoesNaoFactiveis = 0;
+
+    start = clock();
+} // void reiniciaEstado()
 
+/******************************************************************************
+* 	Function: executaProblema												  *
+*	Short Description: Runs the DSGA on the instance set by SetProblema and  *
+*					   writes the result files of that problem.			  *
+*******************************************************************************/
+int executaProblema()
+{
     system("cls");
 
     cout << "sequencing rule: " << strSemente << endl;
@@ -1256,16 +1288,40 @@ int main(int argc, char **argv)
     // remove(ArqCon.c_str());
     // remove(ArqBsi.c_str());
 
+    // Um fluxo do gerador por execucao e problema: a mesma execucao (-s)
+    // repete o resultado, independente dos problemas que vieram antes
+    GARandomSeedStream(intInstancia, intProblema);
+
     int height  = MACHINE;
     int width   = JOB-1;
 
     GA2DBinaryStringGenome genome(width, height, Objective);
 
-    GASteadyStateGA ga(genome);
+    // AG DE ESTADO ESTACIONARIO OU, COM -d, ILHAS EVOLUINDO EM PARALELO COM
+    // MIGRACAO ASSINCRONA EM ANEL
+    GASteadyStateGA *pEstavel = NULL;
+    GAThreadedDemeGA *pIlhas = NULL;
+    EstadoIlhas estadoIlhas;
+
+    if (intIlhas > 0) {
+        pIlhas = new GAThreadedDemeGA(genome);
+        pIlhas->nPopulations(intIlhas);
+        pIlhas->nMigration(1);
+        pIlhas->migrationInterval(5);
+        pIlhas->threadHooks(iniciaThreadIlha, terminaThreadIlha, &estadoIlhas);
+    } else {
+        pEstavel = new GASteadyStateGA(genome);
+    }
+
+    GAGeneticAlgorithm &ga = pIlhas ? (GAGeneticAlgorithm &) *pIlhas : (GAGeneticAlgorithm &) *pEstavel;
     ga.minimize();
 
     ga.populationSize(10);
-    ga.pReplacement(0.9);
+    if (pEstavel) {
+        pEstavel->pReplacement(0.9);
+    } else {
+        pIlhas->nReplacement(GADemeGA::ALL, 9);
+    }
     //ga.nReplacement(80);
     ga.nGenerations(49);
     ga.pMutation(0.01);
@@ -1279,6 +1335,9 @@ int main(int argc, char **argv)
     ga.pConvergence(1);
     ga.nConvergence((int)MACHINE*JOB/2);
     ga.terminator(GAGeneticAlgorithm::TerminateUponConvergence);
+    if (pEstavel) {
+        configuraAvaliador(ga);
+    }
 
     for(int i = 0; i < outIter; i++) {
         primeira_geracao=true;
@@ -1291,25 +1350,40 @@ int main(int argc, char **argv)
 
         ga.initialize();
 
+        // As ilhas partem do estado de busca local da thread principal
+        if (pIlhas) {
+            salvaEstadoBusca(estadoIlhas.inicial);
+            estadoIlhas.resultados.assign(intIlhas, EstadoBuscaLocal());
+        }
+
         while (!ga.done()) {
             cout <<"\rRunning Iteraction " << i+1 << " (of " << outIter <<
             ") and Generation " << ga.generation()+2;
-            ++ga;
+            ga.step();
+        }
+
+        if (pIlhas) {
+            pIlhas->stop();
+            for (int r = 0; r < intIlhas; r++) {
+                mesclaEstadoBusca(estadoIlhas.resultados[r]);
+            }
         }
 
         if (currentCriticalPath.size() > 0 and intAbordagem != 1)  {
             //localSearch4(ga.statistics())
-            localSearch(ga.statistics());
+            if (intTabuIteracoes > 0) {
+                tabuSearch(ga.statistics());
+            } else {
+                localSearch(ga.statistics());
+            }
         } else {
             intSolucoesFactiveis=intSolucoesFactiveis; // APENAS PARA BREAKPOINT
         }
 
     } // for(int i = 0; i < outIter; i++) {
 
-    int P[MACHINE*JOB];
     //Verifica o makespan realizada na busca local.
-    AtualizarVetorComArray( P, S[0]);
-    int scoreFinal = factivel(P,R,1,T);
+    int scoreFinal = avaliaSemente(S[0]);
 
     //Compara o melhor e apresenta o makespan das solues encontradas na busca local de permutacao, insercao e
     if((scoreFinal < bestScorePermutacao) && (scoreFinal < bestScoreInsercao)&& (scoreFinal < bestScoreInsercaoCompleta)){
@@ -1330,6 +1404,7 @@ int main(int argc, char **argv)
     }
     else{
         mostraResultadoFinais(0,scoreFinal);
+        seedFinal = S[0];
     }
 
     cout << endl << endl << " \n Geracao Permutacao " << endl;
@@ -1360,8 +1435,6 @@ int main(int argc, char **argv)
         }
     cout << endl;
 
-    getchar();
-
     cout << "\n\nComplete!!! Please check the following files in your DESKTOP FOLDER: \n\"BestSequenceIdentified.txt\"\n\"Convergence.txt\"\n\n"<<endl;
 
     //Trabalha oa tempo total gasto
@@ -1373,6 +1446,7 @@ int main(int argc, char **argv)
     segundos = (elapsed -(horas_seg*horas)-(minutos*60));
     cout << "-->" << " Elapsed time (in seconds): " << elapsed << "s" << endl;
     printf("--> Elapsed time (human readable): %dh:%dm:%ds",horas,minutos,segundos);
+    printf("\n--> Makespan cache: %lu hits, %lu misses", ctxAvaliacao.iCacheHits, ctxAvaliacao.iCacheMisses);
 
     ofstream fileOut;
     fileOut.open(ArqBsi.c_str(), ios::app);
@@ -1384,12 +1458,40 @@ int main(int argc, char **argv)
     fileOut << "\tNmero de geraes: "<< ga.nGenerations()+1 << endl;
     fileOut << "\tNmero mnimo de geraes para convergncia: "<< ga.nConvergence()<< endl;
     fileOut << "\tTamanho da populao: "<< ga.populationSize() << endl;
-    fileOut << "\tPercentual de substituio da populao: "<< ga.pReplacement()*100 << "%"<<endl;
+    fileOut << "\tPercentual de substituio da populao: "
+            << (pEstavel ? pEstavel->pReplacement()*100 : 100.0*pIlhas->nReplacement(0)/ga.populationSize()) << "%"<<endl;
+    if (pIlhas) {
+        fileOut << "\tIlhas (uma thread cada): "<< pIlhas->nPopulations()
+                << ", migrao a cada "<< pIlhas->migrationInterval() << " geraes"<< endl;
+    }
     fileOut << "\tProbabilidade de cruzamento: "<< ga.pCrossover()*100 << "%"<<endl;
     fileOut << "\tProbabilidade de mutao: "<< ga.pMutation()*100 << "%"<<endl;
     fileOut << "\tNmero de melhores indivduos (para busca local): "<< ga.nBestGenomes() << endl;
+    if (intTabuIteracoes > 0) {
+        fileOut << "\tBusca tabu aps o AG: "<< intTabuIteracoes << " iteraes";
+        if (dblTabuSegundos > 0) {
+            fileOut << " (no mximo "<< dblTabuSegundos << "s)";
+        }
+        fileOut << ", lista tabu de "<< TABUTENURE << " movimentos" << endl;
+    }
+    fileOut << "\tPermutao: "<< (bPermutacaoCompleta ? "todos os pares de cada mquina"
+                                                      : "s pares com operao crtica") << endl;
+    fileOut << "\tBuscas locais por semente: "<< (bOperadoresFixos ? "todas"
+                                                   : "uma, escolhida por ganho por avaliao (UCB descontado)") << endl;
+    for (int k = 0; k < NOPERADORES; k++) {
+        const EstatisticaOperador &op = vetOperadores[k];
+        fileOut << "\t\t" << NOMEOPERADOR[k] << ": " << op.lngChamadas << " chamadas, "
+                << op.lngMelhorias << " melhorias, ganho de " << op.lngGanho << ", "
+                << op.lngAvaliacoes << " avaliaes, " << op.dblMilissegundos << " ms";
+        if (op.dblMilissegundos > 0) {
+            fileOut << ", " << op.lngGanho / op.dblMilissegundos << " por ms";
+        }
+        fileOut << endl;
+    }
     fileOut << "\tNmero de solues factveis: "<< intSolucoesFactiveis << endl;
     fileOut << "\tNmero de solues NO factveis: "<< intSolucoesNaoFactiveis << endl;
+    fileOut << "\tAvaliaes respondidas pelo cache: "<< ctxAvaliacao.iCacheHits
+            << " (de " << ctxAvaliacao.iCacheHits + ctxAvaliacao.iCacheMisses << " consultas)" << endl;
     fileOut.close();
 
     std::stringstream ssHeader;
@@ -1433,16 +1535,34 @@ int main(int argc, char **argv)
     fileHst << ssResult.str() << endl;
     fileHst.close();
 
-    getchar();
+    delete pEstavel;
+    delete pIlhas;
+
     return 0;
-} // Main
+} // int executaProblema()
 
 int SetProblema(int intProblema){
     int r=0, t=0;
     string strProblema;
     string strInstancia = "2";
 
-    #ifdef PROGRAMA_01
+    // Dimensoes de cada grupo de problemas LA
+    if (intProblema >= 1 && intProblema <= 5) {
+        DimensionaInstancia(intProblema, 5, 10);
+    } else if (intProblema >= 6 && intProblema <= 10) {
+        DimensionaInstancia(intProblema, 5, 15);
+    } else if (intProblema >= 11 && intProblema <= 15) {
+        DimensionaInstancia(intProblema, 5, 20);
+    } else if (intProblema >= 16 && intProblema <= 20) {
+        DimensionaInstancia(intProblema, 10, 10);
+    } else if (intProblema >= 21 && intProblema <= 25) {
+        DimensionaInstancia(intProblema, 10, 15);
+    } else {
+        printf( "Problema deve estar entre LA01 e LA25");
+        return 0; // 0 = erro
+    }
+
+    if (intProblema >= 1 && intProblema <= 5) {
 
         if (intProblema == 1){
             intMakeSpanOtimo = 666;
@@ -1521,9 +1641,9 @@ int SetProblema(int intProblema){
 
         }
 
-    #endif
+    }
 
-    #ifdef PROGRAMA_06
+    if (intProblema >= 6 && intProblema <= 10) {
         if (intProblema == 6){
             intMakeSpanOtimo = 926;
 
@@ -1591,7 +1711,7 @@ int SetProblema(int intProblema){
             R[r++]=1; R[r++]=5; R[r++]=3; R[r++]=4; R[r++]=2;       T[t++]=84; T[t++]=64; T[t++]=41; T[t++]=84; T[t++]=78;
             R[r++]=1; R[r++]=4; R[r++]=2; R[r++]=3; R[r++]=5;       T[t++]=63; T[t++]=28; T[t++]=46; T[t++]=26; T[t++]=52;
             R[r++]=4; R[r++]=3; R[r++]=5; R[r++]=2; R[r++]=1;       T[t++]=10; T[t++]=17; T[t++]=73; T[t++]=11; T[t++]=64;
-            R[r++]=SetProblema3; R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1;       T[t++]=67; T[t++]=97; T[t++]=95; T[t++]=38; T[t++]=85;
+            R[r++]=3; R[r++]=2; R[r++]=4; R[r++]=5; R[r++]=1;       T[t++]=67; T[t++]=97; T[t++]=95; T[t++]=38; T[t++]=85;
             R[r++]=3; R[r++]=5; R[r++]=1; R[r++]=2; R[r++]=4;       T[t++]=95; T[t++]=46; T[t++]=59; T[t++]=65; T[t++]=93;
             R[r++]=3; R[r++]=5; R[r++]=4; R[r++]=2; R[r++]=1;       T[t++]=43; T[t++]=85; T[t++]=32; T[t++]=85; T[t++]=60;
             R[r++]=5; R[r++]=4; R[r++]=3; R[r++]=1; R[r++]=2;       T[t++]=49; T[t++]=41; T[t++]=61; T[t++]=66; T[t++]=90;
@@ -1626,11 +1746,11 @@ int SetProblema(int intProblema){
 
         }
 
-    #endif
+    }
 
-    #ifdef PROGRAMA_11
+    if (intProblema >= 11 && intProblema <= 15) {
         if (intProblema == 11){
-            intMakeSpanOtimo = 1222
+            intMakeSpanOtimo = 1222;
             ;
 
 			R[r++]=4; R[r++]=5; R[r++]=3; R[r++]=1; R[r++]=2; 		T[t++]= 5; T[t++]=58; T[t++]=44; T[t++]= 9; T[t++]=58;
@@ -1757,9 +1877,9 @@ int SetProblema(int intProblema){
 
         }
 
-    #endif
+    }
 
-    #ifdef PROGRAMA_16
+    if (intProblema >= 16 && intProblema <= 20) {
         if (intProblema == 16){
             intMakeSpanOtimo = 945;
 
@@ -1837,9 +1957,9 @@ int SetProblema(int intProblema){
 
         }
 
-    #endif
+    }
 
-    #ifdef PROGRAMA_21
+    if (intProblema >= 21 && intProblema <= 25) {
         if (intProblema == 21){
             intMakeSpanOtimo = 1046;
 
@@ -1942,8 +2062,40 @@ int SetProblema(int intProblema){
 
         }
 
-    #endif
-}
+    }
+
+    // Contexto de avaliacao da nova instancia, com cache de makespans vazio
+    // e dimensionado para ela
+    evalFree(&ctxAvaliacao);
+    if (!evalInit(&ctxAvaliacao, &instancia, 1)) {
+        throw bad_alloc();
+    }
+    cacheInit(&ctxAvaliacao, 0);
+    selectInstance(&instancia);
+    intGeracaoInstancia++;
+
+    return 1; // 1 = sucesso
+} // int SetProblema(int intProblema){
+
+/******************************************************************************
+* 	Function: DimensionaInstancia											  *
+*	Short Description: Sets the dimensions of the instance and sizes every   *
+*					   array that depends on them (R, T, vetBestSequence).   *
+*******************************************************************************/
+void DimensionaInstancia(int intProblema, int intMaquinas, int intJobs)
+{
+    instancia.iProblem = intProblema;
+    instancia.iMachines = intMaquinas;
+    instancia.iJobs = intJobs;
+    instancia.iIter = ITERMAX(intJobs);
+
+    vetRotas.assign(intMaquinas*intJobs, 0);
+    vetTempos.assign(intMaquinas*intJobs, 0);
+    R = instancia.vRoutes = &vetRotas[0];
+    T = instancia.vTimes = &vetTempos[0];
+
+    vetBestSequence.assign(intMaquinas*intJobs, 0);
+} // void DimensionaInstancia(int intProblema, int intMaquinas, int intJobs)
 
 /******************************************************************************
 * 	Function: desktopFolder 												  *
@@ -1999,6 +2151,7 @@ void changeSeed(const GAStatistics& g)
     // Estruturas temporarias para sementes
     vector <vector <int> > Stemp(nBestIndividuals);
     vector<int> SS;
+    vector<int> trocas;
     //
     //Antes de mudar a semente eu avalio os trs melhores e identifico a semente que deve mudar
     //
@@ -2007,22 +2160,16 @@ void changeSeed(const GAStatistics& g)
         // Pega o n-esimo individuo da lista dos melhores
         GA2DBinaryStringGenome & genome = (GA2DBinaryStringGenome &)g.bestIndividual(n);
         //bestCurrent = ITER;
-        int P[MACHINE*JOB];
         vector<int> score(nBestIndividuals);
+        loteLimpa(loteVizinhos);
+        // Trocas do genoma, levantadas uma vez para todas as sementes
+        listaTrocasGenoma(genome, trocas);
         //Permuta todas as sementes em S com base no genoma 'genome'
         for (int num = 0; num < nBestIndividuals; num++) {
             // Copia S para uma estrutura temporaria que sofrer permutao
             SS = S[num];
             //
-            for(int i=0; i<genome.width(); i++) {
-                for(int j=0; j<genome.height(); j++) {
-                    if(genome.gene(i,j) == 1) {
-                        int val = SS[(j*JOB)+i];
-                        SS[(j*JOB)+i] = SS[(j*JOB)+i+1];
-                        SS[(j*JOB)+i+1] = val;
-                    } // IF
-                } // FOR
-            } // FOR
+            applyGenomeToSeed(SS, trocas);
 
 //            int block = -1;
 //            for(int i=0; i<MACHINE*JOB; i++) {
@@ -2031,12 +2178,16 @@ void changeSeed(const GAStatistics& g)
 //                P[(block*JOB)+SS[i]-1] = p;
 //            } // FOR
 
-            // Guarda os valores de aptidao
-            AtualizarVetorComArray( P, SS );
-            score[num] = factivel(P,R,1,T);
+            loteAdiciona(loteVizinhos, SS);
 
         } // FOR
 
+        // Guarda os valores de aptidao
+        loteAvalia(loteVizinhos, ITER);
+        for (int num = 0; num < nBestIndividuals; num++) {
+            score[num] = loteVizinhos.vetMakespans[num];
+        }
+
         vector<int> scoreV2(score);
         sort(scoreV2.begin(),scoreV2.end());
         int pos = find(score.begin(),score.end(), scoreV2[0]) - score.begin();
@@ -2052,16 +2203,7 @@ void changeSeed(const GAStatistics& g)
         // Pega a semente que deve sofrer permutacao
         Stemp[n] = S[bestSeedsIndex[n]];
         // Aplica permutao
-
-        for(int i=0; i<genome.width(); i++) {
-            for(int j=0; j<genome.height(); j++) {
-                if(genome.gene(i,j) == 1) {
-                    int val = Stemp[n][(j*JOB)+i];
-                    Stemp[n][(j*JOB)+i] = Stemp[n][(j*JOB)+i+1];
-                    Stemp[n][(j*JOB)+i+1] = val;
-                } // IF
-            } // FOR
-        } // FOR
+        applyGenomeToSeed(Stemp[n], genome);
     } // FOR
     // Atualiza a semente original S
     S = Stemp;
@@ -2121,15 +2263,13 @@ int * OrderVectorFIFO( int pVetor[], int pOrder)
 {
     int aux = 0;
     int scoreOrderDepois;
-    int P[MACHINE*JOB]; // VETOR PARA AVALIAR FACTIBILIDADE
 
     boolean blnOrdena;
 
     int intTempo1, intTempo2, intJob1, intJob2, temp, intElemento1, intElemento2, intColuna = 0;
     //  static int vRetorno[JOB*MACHINE];
 
-    AtualizarVetorComVetor( P, pVetor );
-    scoreOrderDepois = factivel(P, R, 1, T);
+    scoreOrderDepois = decodeSeed(&ctxAvaliacao, pVetor, NULL);
 
     // CLASSIFICAO DOS JOBS DE ACORDO COM A MAQUINA
     for (int iMaq=0; iMaq < MACHINE; iMaq++) { // PERCORRE CADA "LINHA" DA MATRIZ, REPRESENTANDO UMA MQUINA
@@ -2165,16 +2305,14 @@ int * OrderVectorFIFO( int pVetor[], int pOrder)
 
                         //avalia a semente e atualiza valor de aptido em scoreTopList
 
-                        AtualizarVetorComVetor( P, pVetor );
-                        scoreOrderDepois = factivel(P, R, 1, T);
+                        scoreOrderDepois = decodeSeed(&ctxAvaliacao, pVetor, NULL);
 
                         // SE A SOLUO NO FOR FACTIVEL, DESFAZ A PERMUTAO.
                         if (scoreOrderDepois == ITER) {
                             pVetor[intElemento2] = pVetor[intElemento1];
                             pVetor[intElemento1] = temp;
 
-                            AtualizarVetorComVetor( P, pVetor );
-                            scoreOrderDepois = factivel(P, R, 1, T);
+                            scoreOrderDepois = decodeSeed(&ctxAvaliacao, pVetor, NULL);
 
                         } else {
                             temp=temp; // APENAS PARA DEBUGAR
@@ -2194,16 +2332,14 @@ int * OrderVectorFIFO( int pVetor[], int pOrder)
 
     } // for (int iMaq=0; iMaq < MACHINE; iMaq++) {
 
-    AtualizarVetorComVetor( P, pVetor );
-    scoreOrderDepois = factivel(P, R, 1, T);
+    scoreOrderDepois = decodeSeed(&ctxAvaliacao, pVetor, NULL);
 
     // SE A SOLUO NO FOR FACTIVEL, DESFAZ A PERMUTAO.
     if (scoreOrderDepois == ITER) {
         pVetor[intElemento2] = pVetor[intElemento1];
         pVetor[intElemento1] = temp;
 
-        AtualizarVetorComVetor( P, pVetor );
-        scoreOrderDepois = factivel(P, R, 1, T);
+        scoreOrderDepois = decodeSeed(&ctxAvaliacao, pVetor, NULL);
 
     } else {
         temp=temp; // APENAS PARA DEBUGAR
@@ -2300,9 +2436,11 @@ return pVetor;
 int * gera_sequencia (int rota[])
 {
     int i, aux1=0, aux2=0, conta_job=1;
-    static int s_temp[MACHINE*JOB];
+    static vector<int> s_temp;
 
-    while(conta_job<JOB+1){
+    s_temp.assign(MACHINE*JOB, 0);
+
+    while(conta_job<MACHINE+1){ // UMA PASSADA POR MAQUINA
         for(i=0; i<JOB; i++) { //  VARRE OS JOBS POR MAQUINA
             // SE O JOB ATUAL DA MQUINA = JOB ANALISADO
             if(rota[i*MACHINE+aux1]==conta_job) {
@@ -2329,7 +2467,7 @@ int * gera_sequencia (int rota[])
 
     }
 */
-    return s_temp;
+    return &s_temp[0];
 
 } // int * gera_sequencia (int rota[])
 
@@ -2340,9 +2478,8 @@ int * gera_sequencia (int rota[])
 void setup()
 {
     int * ss = gera_sequencia(R); // GERA SEMENTE INICIAL COM ABORDAGEM FIFO
-    int P[MACHINE*JOB];
 
-    S.clear();
+    S.assign(nBestIndividuals, vector<int>());
 
     for (int num = 0; num < nBestIndividuals; num++){
         for(int sem = 0; sem < JOB*MACHINE; sem++){
@@ -2356,8 +2493,7 @@ void setup()
     int score; // = factivel(P,R,1,T);
 
     // Calcula aptidao da semente
-    AtualizarVetorComArray(P, S[0]);
-    score = factivel(P,R,1,T);
+    score = avaliaSemente(S[0]);
 
     // Calcula Caminho Critico
     findCriticalPath(S[0]);
@@ -2365,420 +2501,101 @@ void setup()
     //Faz busca local na semente inicial e atualiza S[0]
     bestCurrent = ITER;
 
-    // Calcula aptidao da semente
-    //AtualizarVetorComArray(P, S[0]);
-    //score = factivel(P,R,1,T);
-
-    if (intAbordagem==1){ // SEMENTE INICIAL NO FACTIVEL
-
-        for (int intMaquina=0; intMaquina < MACHINE; intMaquina++){
-            // REALIZA UM EMBARALHAMENTO DOS JOBS COM A INTENO DE PRODUZIR UMA SOLUO NO-FACTIVEL
-            std::random_shuffle(S[intMaquina].begin(),S[intMaquina].end());
-
-            // Calcula aptidao da semente
-            AtualizarVetorComArray( P, S[0] );
-            score = factivel(P,R,1,T);
-
-            // SE A SOLUO NO FOR FACTVEL, SAI DO LAO FOR
-            if (score == ITER) {
-                break;
-            }
-
-        }
-
-    } else if (intAbordagem==3){
-        OrderVectorFIFO(ss,1); // FIFO + SPT
-
-    } else if (intAbordagem==4){
-        OrderVectorFIFO(ss,2); // FIFO + LPT
-
-    } else if (intAbordagem==5){
-        // OrderVectorNEH( ss ); // FIFO + LPT
-        OrderVectorNEH( ss );
-    }
-
-        /*
-        S.clear();
-
-        for (int num = 0; num < nBestIndividuals; num++){
-            for(int sem = 0; sem < JOB*MACHINE; sem++){
-                S[num].push_back(ss[sem]);
-                // S[num][sem] = ss[sem];
-
-            }
-        }
-
-        // Calcula aptidao da semente
-        AtualizarVetorComArray( P, S[0] );
-        score = factivel(P,R,1,T);
-
-
-        for (int num = 0; num < nBestIndividuals; num++){
-            for(int sem = 0; sem < JOB*MACHINE; sem++){
-                S[num].push_back(ss[sem]);
-            }
-        }
-        */
-
-        cout << "-->" << " Score Inicial: " << score << " - MakeSpan: " << intMakeSpanOtimo << endl;
-        bestCurrent = score;
-        // Inicialmente, todos os  valores so iguais
-        for (int num = 0; num < nBestIndividuals; num++)
-            scoreTopList[num] = score;
-
-        cout << endl << "score: " << bestCurrent << endl;
-        //getchar();
-} // setup()
-
-//
-//*****************************************************************************
-// calculate the makespan based on the critical path method
-int projectDuration(vector<int> Seed)
-{
-    //
-    int *p;
-    vector<int> startVec;
-    vector<int> endVec;
-    vector<int> timeVec;
-
-    // Cria arestas do grafo
-    for(int j=0; j<JOB; j++)
-    {
-            startVec.push_back(0);
-            timeVec.push_back(0);
-
-            for(int m=1; m<=MACHINE; m++)
-            {
-                    //
-                    endVec.push_back(j*MACHINE+m); //1-index
-                    startVec.push_back(j*MACHINE+m); //1-index
-                    timeVec.push_back(T[j*MACHINE+m-1]); //0-index
-            }
-            endVec.push_back(JOB*MACHINE+1);
-    }
-    //
-    for(int m=0; m<MACHINE; m++)
-    {
-            for(int j=0; j<JOB; j++)
-            {
-                    int job = Seed[m*JOB+j] - 1;
-                    // Vai na 'linha' de R referente ao job
-                    int start = job * MACHINE;
-                    int end = job * MACHINE + MACHINE - 1;
-                    p = std::find(R+start,R+end, m+1);
-
-                    //Posicao
-                    int pos = p - (R+start);
-                    int no = job*MACHINE + pos + 1;
-                    //
-                    // Coloca na lista de arestas
-                    if(j == 0)
-                    {
-                         //seta apenas como n inicial
-                         startVec.push_back(no); //1-index
-                         timeVec.push_back(T[no-1]); //0-index
-                    }
-                    if(j == JOB-1)
-                    {
-                         //seta apenas como n final
-                         endVec.push_back(no); //1-index
-                    }
-                    if(j != 0 && j != JOB-1)
-                    {
-                        //seta como inicial e final
-                        startVec.push_back(no); //1-index
-                        endVec.push_back(no); //1-index
-                        timeVec.push_back(T[no-1]); //0-index
-                    }
-            }
-    }
-    ////////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////////
-    int numberVertex = MACHINE*JOB + 2;   // number  of vertex
-    int numberActivities = endVec.size(); // number of edges
-//    int i, j;
-    int j;
-
-    /*vertices are of the form (v, u) */
-    //indegree of each vertex (that is, count the number of edges entering them)
-    vector<int> indegree(numberVertex, 0);
-
-    std::vector<int> v(startVec);
-    std::vector<int> u(endVec);
-    std::vector<int> d(timeVec);
-
-    int project_duration=0;//project duration
-
-
-    /*# Compute the indegree for each vertex v from the graph:
-    for each neighbor u of v: indegree[u] += 1*/
-    for (j=0; j<numberActivities; j++){
-        indegree[u[j]]++;
-    }
-
-    queue<int> Q; //queue Q = empty queue
-    int distance [numberVertex];
-    memset(distance, 0, sizeof(int) * numberVertex);//distance = array filled with zeroes
-
-    //vetor de conjuntos de nos
-    vector< set<int> > vecSetCriticalPath(numberVertex);
-
-    //for each vertex v:
-    //if indegree[v] = 0:
-    //insert v on Q
-    for (j=0; j<numberVertex; j++)
-    {
-        if (indegree[j]==0)
-            Q.push(v[j]);
-    }
-
-    int first;
-
-    //printf ("first in the queue=%d\n", Q.front());
-
-    /*for each neighbor u of v:
-    d istance[u] = max(distance[u], distance[v] + time(v, u))
-    indegree[u] -= 1
-    if indegree[u] = 0:
-    insert u on Q
-    */
-    while (!Q.empty()){ //while Q is not empty:
-
-     first= Q.front();  //v = get front element from Q
-     Q.pop(); //delete de first from queue
-
-     //Para todo vizinho de first faca
-     for(int i = 0;i < numberActivities;i++) //**********MELHORAR ESSA ESTRUTURA **********
-     {
-        if(v[i] == first) //
-        {
-                //////////////////////////////////////////////////////////////
-                //
-                distance[u[i]]=std::max(distance[u[i]], distance[v[i]]+ d[i]);
-                indegree[u[i]]-=1;
-                ////////////////////////////////////////////////////////////////
-
-                if (indegree[u[i]]==0){
-                   Q.push(u[i]);
-                }
-        }
-     }
-   }//fecha while
-
-    /*Now, select the vertex x with the largest distance.
-    This is the minimum total project_duration.*/
-    project_duration = *std::max_element(distance,distance+numberVertex);
-    return project_duration;
-} // projectDuration
-
-/******************************************************************************
-* void findCriticalPath
-*******************************************************************************/
-void findCriticalPath(vector<int> s)
-{
-    //
-    int *p;
-    vector<int> startVec;
-    vector<int> endVec;
-    vector<int> timeVec;
-
-    // Cria arestas do grafo
-    for(int j=0; j<JOB; j++) {
-        startVec.push_back(0);
-        timeVec.push_back(0);
+    // Calcula aptidao da semente
+    //AtualizarVetorComArray(P, S[0]);
+    //score = factivel(P,R,1,T);
 
-        for(int m=1; m<=MACHINE; m++) {
-            //
-            endVec.push_back(j*MACHINE+m); //1-index
-            startVec.push_back(j*MACHINE+m); //1-index
-            timeVec.push_back(T[j*MACHINE+m-1]); //0-index
-        }
-        endVec.push_back(JOB*MACHINE+1);
-    }
-    //
-    //    for(int j=0; j<endVec.size(); j++)
-    //    {
-    //            cout << startVec[j] << "  " << endVec[j] << "  " << timeVec[j] << endl;
-    //    }
-    //    getchar();
-    //
-    for(int m=0; m<MACHINE; m++) {
-        for(int j=0; j<JOB; j++) {
-            int job = s[m*JOB+j] - 1;
-            // cout << "Job: " << job+1 << endl;
-            // Vai na 'linha' de R referente ao job
-            int start = job * MACHINE;
-            int end = job * MACHINE + MACHINE - 1;
-            //cout << "start = " << start << " end = " << end << endl;
-            p = std::find(R+start,R+end, m+1);
-
-            //cout << "Maq: " << m+1 << endl;
-            //Posicao
-            int pos = p - (R+start);
-            //cout << "Operacao: " << pos+1 << endl;
-            int no = job*MACHINE + pos + 1;
-            //cout << endl << "****No***** " << no << endl;
-            //
-            // Coloca na lista de arestas
+    if (intAbordagem==1){ // SEMENTE INICIAL NO FACTIVEL
 
-            if(j == 0) {
-                //seta apenas como n inicial
-                startVec.push_back(no); //1-index
-                timeVec.push_back(T[no-1]); //0-index
-            }
+        for (int intMaquina=0; intMaquina < MACHINE; intMaquina++){
+            // REALIZA UM EMBARALHAMENTO DOS JOBS COM A INTENO DE PRODUZIR UMA SOLUO NO-FACTIVEL
+            std::random_shuffle(S[0].begin() + intMaquina*JOB, S[0].begin() + (intMaquina+1)*JOB);
 
-            if(j == JOB-1) {
-                //seta apenas como n final
-                endVec.push_back(no); //1-index
+            // SE A SOLUO NO FOR FACTVEL, SAI DO LAO FOR
+            // (TESTE DE CICLO NO GRAFO DISJUNTIVO, SEM SIMULAR OS TEMPOS)
+            if (!seedFeasible(&ctxAvaliacao, &S[0][0])) {
+                break;
             }
 
-            if(j != 0 && j != JOB-1) {
-                //seta como inicial e final
-                startVec.push_back(no); //1-index
-                endVec.push_back(no); //1-index
-                timeVec.push_back(T[no-1]); //0-index
-            }
         }
-    //            //
-    }
-    //    getchar();
-    //    for(int j=0; j<endVec.size(); j++)
-    //    {
-    //            cout << startVec[j] << "  " << endVec[j] << "  " << timeVec[j] << "  " << endVec.size() << endl;
-    //    }
-    //
-    //    getchar();
 
+        // Calcula aptidao da semente
+        score = avaliaSemente(S[0]);
 
-    ////////////////////////////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////////////////////////////
-    int numberVertex = MACHINE*JOB + 2;   // number  of vertex
-    int numberActivities = endVec.size(); // number of edges
-    //    int i, j;
-    int j;
+    } else if (intAbordagem==3){
+        OrderVectorFIFO(ss,1); // FIFO + SPT
 
-    /*vertices are of the form (v, u) */
-    //indegree of each vertex (that is, count the number of edges entering them)
-    vector<int> indegree(numberVertex, 0);
+    } else if (intAbordagem==4){
+        OrderVectorFIFO(ss,2); // FIFO + LPT
 
-    std::vector<int> v(startVec);
-    std::vector<int> u(endVec);
-    std::vector<int> d(timeVec);
+    } else if (intAbordagem==5){
+        // OrderVectorNEH( ss ); // FIFO + LPT
+        OrderVectorNEH( ss );
+    }
 
-    //    for (j=0;j<numberActivities; j++)
-    //        cout << "***** " << v[j] << "  " << u[j] << "  " << d[j] << endl;
-    //    getchar();
+        /*
+        S.clear();
 
-    int project_duration=0;//project duration
+        for (int num = 0; num < nBestIndividuals; num++){
+            for(int sem = 0; sem < JOB*MACHINE; sem++){
+                S[num].push_back(ss[sem]);
+                // S[num][sem] = ss[sem];
 
+            }
+        }
 
-    /*# Compute the indegree for each vertex v from the graph:
-    for each neighbor u of v: indegree[u] += 1*/
-    for (j=0; j<numberActivities; j++){
-        indegree[u[j]]++;
-    }
+        // Calcula aptidao da semente
+        score = avaliaSemente(S[0]);
 
-    //    for (j=0;j<numberVertex; j++)
-    //        printf ("indegree %d= %d\n",j,indegree[j] );
-    //getchar();
 
-    queue<int> Q; //queue Q = empty queue
-    int distance [numberVertex];
-    memset(distance, 0, sizeof(int) * numberVertex);//distance = array filled with zeroes
+        for (int num = 0; num < nBestIndividuals; num++){
+            for(int sem = 0; sem < JOB*MACHINE; sem++){
+                S[num].push_back(ss[sem]);
+            }
+        }
+        */
 
-    //vetor de conjuntos de nos
-    vector< set<int> > vecSetCriticalPath(numberVertex);
+        cout << "-->" << " Score Inicial: " << score << " - MakeSpan: " << intMakeSpanOtimo << endl;
+        bestCurrent = score;
+        // Inicialmente, todos os  valores so iguais
+        for (int num = 0; num < nBestIndividuals; num++)
+            scoreTopList[num] = score;
 
-    //for each vertex v:
-    //if indegree[v] = 0:
-    //insert v on Q
-    for (j=0; j<numberVertex; j++)
-    {
-        if (indegree[j]==0)
-            Q.push(v[j]);
-    }
-
-    int first;
-
-    //printf ("first in the queue=%d\n", Q.front());
-
-    /*for each neighbor u of v:
-    d istance[u] = max(distance[u], distance[v] + time(v, u))
-    indegree[u] -= 1
-    if indegree[u] = 0:
-    insert u on Q
-    */
-    while (!Q.empty()){ //while Q is not empty:
-        first= Q.front();  //v = get front element from Q
-        Q.pop(); //delete de first from queue
-
-        //Para todo vizinho de first faca
-        for(int i = 0;i < numberActivities;i++) { //**********MELHORAR ESSA ESTRUTURA **********
-            if(v[i] == first) {
-                //////////////////////////////////////////////////////////////
-                distance[u[i]]=std::max(distance[u[i]], distance[v[i]]+ d[i]);
-                indegree[u[i]]-=1;
-                ////////////////////////////////////////////////////////////////
-
-                if (indegree[u[i]]==0){
-                   Q.push(u[i]);
-                }
-            } // fecha IF
-        } // fecha for
-        ////////////////////////////////////////////
-        //
-        //for(int ii=0; ii<numberVertex; ii++)
-        //cout << *std::max_element(distance,distance+numberVertex) << endl;
+        cout << endl << "score: " << bestCurrent << endl;
         //getchar();
-        ////////////////////////////////////////////
-   }//fecha while
+} // setup()
 
+//
+//*****************************************************************************
+// calculate the makespan based on the critical path method
+int projectDuration(vector<int> Seed)
+{
+    // Grafo disjuntivo em CSR e CPM em uma passada (ver analyzeSeed())
+    return analyzeSeed(&ctxAvaliacao, &Seed[0], NULL, NULL, NULL, NULL);
 
-    /*Now, select the vertex x with the largest distance.
-    This is the minimum total project_duration.*/
-    project_duration = *std::max_element(distance,distance+numberVertex);
-    //printf ("Total Project Duration %d\n", project_duration);
-    //getchar();
-    ////////////////////////////////////////////////////////////////////////////
-    // Pega posicao do elemento mximo = primeiro na 'lista critica'
-    int criticalNode = std::find(distance, distance+numberVertex, project_duration) - distance;
-    vector<int> criticalPath;
-    //criticalPath.push_back(criticalNode);
-    ////////////////////////////////////////////////////////////////////////////
-    while(criticalNode != 0){
-        vector<int> neighborhood;
-        vector<int> neighDistances;
-        //
-        // varre recursivamente os vizinhos e pega o mximo
-        for(int i = 0;i < numberActivities;i++) {//**********MELHORAR ESSA ESTRUTURA **********
-            if(u[i] == criticalNode) {
-                neighborhood.push_back(v[i]);
-                neighDistances.push_back(distance[v[i]]);
-                //cout << v[i] << " " << distance[v[i]] << endl;
-                //getchar();
-            }
-        }
+} // projectDuration
 
-        int max = *std::max_element(neighDistances.begin(),neighDistances.end());
-        int pp =  std::find(neighDistances.begin(), neighDistances.end(), max) - neighDistances.begin();
-        if(max == 0) pp = neighDistances.size() - 1;
-        criticalNode = neighborhood[pp];
-        criticalPath.push_back(criticalNode);
-        //cout << "criticalNode = " << criticalNode << "Max: " << max << endl;
-    }
-    //getchar();
-    ////////////////////////////////////////////////////////////////////////////
-    //    cout << "criticalPath: " << endl;
-    //    for (int j=0; j<criticalPath.size(); j++)
-    //        cout << criticalPath[j] << endl;
-    //intSolucoesFactiveis
-    //    cout << '\n';
+/******************************************************************************
+* int findCriticalPath
+*	Caminho critico da semente em currentCriticalPath (nos op+1, do fim para
+*	o inicio, terminando em 0) e, na mesma passada, as cabecas e caudas das
+*	operacoes em vetCabecas e vetCaudas (ver estimaTroca()). Devolve o
+*	makespan (ITER se a semente nao for factivel).
+*******************************************************************************/
+int findCriticalPath(const vector<int> &s)
+{
+    int intTamanho = 0;
 
-    currentCriticalPath = criticalPath;
+    vetCabecas.resize(MACHINE*JOB);
+    vetCaudas.resize(MACHINE*JOB);
+    currentCriticalPath.resize(MACHINE*JOB+2);
 
-//    system("PAUSE");
+    int intMakespan = analyzeSeed(&ctxAvaliacao, &s[0], &vetCabecas[0], &vetCaudas[0],
+                                  &currentCriticalPath[0], &intTamanho);
 
-return;
+    currentCriticalPath.resize(intTamanho);
+
+    return intMakespan;
 } // findCriticalPath
 
 //
@@ -2791,30 +2608,30 @@ return;
 
 float Objective(GAGenome& g)
 {
-    cout << " Entrou em Objective " << endl;
+    ostream &saida = saidaAvaliacao();
+
+    saida << " Entrou em Objective " << endl;
 //    getchar();
 
     GA2DBinaryStringGenome & genome = (GA2DBinaryStringGenome &)g;
     vector<int> score(nBestIndividuals);
-    int val = 0;
     //    int count=0;
     //    unsigned int i, j;
 
-    int P[MACHINE*JOB];
     //    int lin_1, col_1, lin_2, col_2;
     // Na primeira gerao apenas adiciona a semente na populao
     // A aptido j foi calculada no setup ou na changeSeed
     if (primeira_geracao==true) {
-        cout << "// Coloca individuo nulo na populao" << endl;
+        saida << "// Coloca individuo nulo na populao" << endl;
         genome.unset(0,0,genome.width(),genome.height());
         //
         primeira_geracao=false;
 
-                cout << " \n Primeira geracao em Objective " << endl;
-                cout << " Semente: " << endl;
+                saida << " \n Primeira geracao em Objective " << endl;
+                saida << " Semente: " << endl;
                 for (int num = 0; num < S[0].size(); num++)
-                    cout << S[0][num] << ", ";
-                cout << endl;
+                    saida << S[0][num] << ", ";
+                saida << endl;
                 //getchar();
         // Retorna o valor de aptidao da melhor semente
         return bestCurrent;
@@ -2824,29 +2641,22 @@ float Objective(GAGenome& g)
         /// TESTA O GENOMA
         /////////////////////////////////////////////
         //Permuta todas as sementes em S com base no genoma 'genome'
-        cout << "Testa genoma" << endl;
+        saida << "Testa genoma" << endl;
 
         vector<int> SS;
+        vector<int> trocas;
+        // Trocas do genoma, levantadas uma vez para todas as sementes
+        listaTrocasGenoma(genome, trocas);
         //bestCurrent = ITER;
         for (int num = 0; num < nBestIndividuals; num++) {
             // Copia S para uma estrutura temporaria que sofrer permutao
 
             SS = S[num];
             //
-            for(int i=0; i<genome.width(); i++) {
-                for(int j=0; j<genome.height(); j++) {
-                    if(genome.gene(i,j) == 1) {
-                        val = SS[(j*JOB)+i];
-                        SS[(j*JOB)+i] = SS[(j*JOB)+i+1];
-                        SS[(j*JOB)+i+1] = val;
-                    }
-                }
-            }
-            cout << "-----Saindo teste genoma-----";
+            applyGenomeToSeed(SS, trocas);
+            saida << "-----Saindo teste genoma-----";
             // Apenas o menor score interessa.
-            AtualizarVetorComArray( P, SS );
-
-            score[num] = factivel(P,R,1,T);
+            score[num] = avaliaSemente(SS);
 
             // Conta as solues factiveis
             if (score[num] < ITER) {
@@ -2856,20 +2666,30 @@ float Objective(GAGenome& g)
             }
 
 
+            // Uma busca local por semente, a que esta rendendo mais (ou
+            // todas, com -opfixo)
+            int intOperador = bOperadoresFixos ? -1 : escolheOperador();
+
             //Metodo de permutacao.
-            cout << endl << "------Metodo de permutacao------" << endl;
-            permutacao(SS, score[num]);
-            cout << endl << "-------Saindo permutacao------" << endl;
+            if (intOperador < 0 || intOperador == 0) {
+                saida << endl << "------Metodo de permutacao------" << endl;
+                executaOperador(0, SS, score[num]);
+                saida << endl << "-------Saindo permutacao------" << endl;
+            }
 
             //Metodo de insercao
-            cout << endl << "------Metodo de insercao------" << endl;
-            entrarInsercao(SS, score[num]);
-            cout << endl << "-----Saindo insercao-----" << endl;
+            if (intOperador < 0 || intOperador == 1) {
+                saida << endl << "------Metodo de insercao------" << endl;
+                executaOperador(1, SS, score[num]);
+                saida << endl << "-----Saindo insercao-----" << endl;
+            }
 
             //Metodo de insercao completa
-            cout << endl << "------Metodo de insercao completa------" << endl;
-            insercaoCompleta(SS, score[0]);
-            cout << endl << "-------Saindo insercao completa---------" << endl;
+            if (intOperador < 0 || intOperador == 2) {
+                saida << endl << "------Metodo de insercao completa------" << endl;
+                executaOperador(2, SS, score[0]);
+                saida << endl << "-------Saindo insercao completa---------" << endl;
+            }
 
             //if(bestScorePermutacao < bestScoreInsercao)
             //    score[0] = bestScorePermutacao;
@@ -2882,7 +2702,7 @@ float Objective(GAGenome& g)
             ///////////////////////////////////////////////////
             /*if (score[0] < score_ant) {
                 for (int seq = 0; seq < JOB*MACHINE; seq++){
-                    cout << listaSolucaoPermutacao[seq] << endl;
+                    saida << listaSolucaoPermutacao[seq] << endl;
                     vetBestSequence[seq] = listaSolucaoPermutacao[seq];
                 }
                 return (float)score[0];
@@ -2916,6 +2736,197 @@ float Objective(GAGenome& g)
      return (float)score[0];*/
 } // Objective(GAGenome& g)
 
+// Saida das mensagens de Objective(): cout na thread principal; nas threads
+// do pool as mensagens sao descartadas (nao se misturam na tela)
+ostream &saidaAvaliacao()
+{
+    static thread_local ostream osDescarta(NULL);
+
+    return threadAuxiliar ? osDescarta : cout;
+} // ostream &saidaAvaliacao()
+
+// Dados de uma chamada de poolRun() em avaliaPopulacaoParalela()
+struct TarefaAvaliacao {
+    GAPopulation *pPopulacao;
+    int intPrimeiro;                        // individuo da tarefa 0
+    const EstadoBuscaLocal *pInicial;       // estado da thread principal
+    vector<EstadoBuscaLocal> *pResultados;  // um por tarefa
+};
+
+// Contexto de avaliacao de uma thread do pool, refeito quando a instancia
+// muda e liberado quando a thread termina (poolStop())
+struct ContextoThread {
+    int intGeracao;
+    ~ContextoThread() { evalFree(&ctxAvaliacao); }
+};
+thread_local ContextoThread contextoThread;
+
+// Estado de busca local da thread em pEstado
+void salvaEstadoBusca(EstadoBuscaLocal &pEstado)
+{
+    pEstado.bestScorePermutacao = bestScorePermutacao;
+    pEstado.bestScoreInsercao = bestScoreInsercao;
+    pEstado.bestScoreInsercaoCompleta = bestScoreInsercaoCompleta;
+    pEstado.listaSolucaoPermutacao = listaSolucaoPermutacao;
+    pEstado.listaSolucaoInsercao = listaSolucaoInsercao;
+    pEstado.listaSolucaoInsercaoCompleta = listaSolucaoInsercaoCompleta;
+    pEstado.intSolucoesFactiveis = intSolucoesFactiveis;
+    pEstado.intSolucoesNaoFactiveis = intSolucoesNaoFactiveis;
+    pEstado.iCacheHits = ctxAvaliacao.iCacheHits;
+    pEstado.iCacheMisses = ctxAvaliacao.iCacheMisses;
+    for (int k = 0; k < NOPERADORES; k++) {
+        pEstado.operadores[k] = vetOperadores[k];
+    }
+} // void salvaEstadoBusca(EstadoBuscaLocal &pEstado)
+
+// A thread (do pool ou de uma ilha) recomeca a busca local de pEstado, com
+// os contadores zerados: o que ela salvar depois sera so o que ela fez
+void restauraEstadoBusca(const EstadoBuscaLocal &pEstado)
+{
+    bestScorePermutacao = pEstado.bestScorePermutacao;
+    bestScoreInsercao = pEstado.bestScoreInsercao;
+    bestScoreInsercaoCompleta = pEstado.bestScoreInsercaoCompleta;
+    listaSolucaoPermutacao = pEstado.listaSolucaoPermutacao;
+    listaSolucaoInsercao = pEstado.listaSolucaoInsercao;
+    listaSolucaoInsercaoCompleta = pEstado.listaSolucaoInsercaoCompleta;
+    intSolucoesFactiveis = 0;
+    intSolucoesNaoFactiveis = 0;
+    ctxAvaliacao.iCacheHits = 0;
+    ctxAvaliacao.iCacheMisses = 0;
+    // A escolha dos operadores parte do que a thread principal sabe
+    for (int k = 0; k < NOPERADORES; k++) {
+        vetOperadores[k] = pEstado.operadores[k];
+        vetOperadores[k].lngChamadas = 0;
+        vetOperadores[k].lngMelhorias = 0;
+        vetOperadores[k].lngGanho = 0;
+        vetOperadores[k].lngAvaliacoes = 0;
+        vetOperadores[k].dblMilissegundos = 0;
+    }
+} // void restauraEstadoBusca(const EstadoBuscaLocal &pEstado)
+
+// Thread auxiliar (pool ou ilha): sem mensagens e com contexto de avaliacao
+// proprio, refeito quando a instancia muda
+void preparaThreadAvaliacao()
+{
+    threadAuxiliar = true;
+
+    if (contextoThread.intGeracao != intGeracaoInstancia) {
+        evalFree(&ctxAvaliacao);
+        if (!evalInit(&ctxAvaliacao, &instancia, 1)) {
+            throw bad_alloc();
+        }
+        cacheInit(&ctxAvaliacao, 0);
+        loteVizinhos.vetSementes.clear();
+        loteVizinhos.intCapacidade = 0;
+        loteVizinhos.intQuantidade = 0;
+        contextoThread.intGeracao = intGeracaoInstancia;
+    }
+} // void preparaThreadAvaliacao()
+
+// Tarefa do pool: avalia o individuo intPrimeiro + intTarefa a partir do
+// estado inicial da thread principal e guarda o estado resultante
+void avaliaGenomaPool(int intTarefa, int intThread, void *pDados)
+{
+    TarefaAvaliacao &tarefa = *(TarefaAvaliacao *) pDados;
+
+    preparaThreadAvaliacao();
+    restauraEstadoBusca(*tarefa.pInicial);
+
+    tarefa.pPopulacao->individual(tarefa.intPrimeiro + intTarefa).evaluate();
+
+    salvaEstadoBusca((*tarefa.pResultados)[intTarefa]);
+} // void avaliaGenomaPool(int intTarefa, int intThread, void *pDados)
+
+// Fica com a solucao da thread do pool se ela for melhor (0 = nenhuma ainda)
+void mesclaMelhor(int &intMelhor, vector<int> &vetMelhor, int intNovo, const vector<int> &vetNovo)
+{
+    if (intNovo > 0 && (intMelhor == 0 || intNovo < intMelhor)) {
+        if (intMelhor > 0) {
+            mostraMelhoria(intNovo);
+        }
+        intMelhor = intNovo;
+        vetMelhor = vetNovo;
+    }
+} // void mesclaMelhor(...)
+
+// Mescla na thread principal o estado devolvido por uma thread auxiliar
+void mesclaEstadoBusca(const EstadoBuscaLocal &pEstado)
+{
+    mesclaMelhor(bestScorePermutacao, listaSolucaoPermutacao,
+                 pEstado.bestScorePermutacao, pEstado.listaSolucaoPermutacao);
+    mesclaMelhor(bestScoreInsercao, listaSolucaoInsercao,
+                 pEstado.bestScoreInsercao, pEstado.listaSolucaoInsercao);
+    mesclaMelhor(bestScoreInsercaoCompleta, listaSolucaoInsercaoCompleta,
+                 pEstado.bestScoreInsercaoCompleta, pEstado.listaSolucaoInsercaoCompleta);
+
+    intSolucoesFactiveis += pEstado.intSolucoesFactiveis;
+    intSolucoesNaoFactiveis += pEstado.intSolucoesNaoFactiveis;
+    ctxAvaliacao.iCacheHits += pEstado.iCacheHits;
+    ctxAvaliacao.iCacheMisses += pEstado.iCacheMisses;
+    mesclaOperadores(pEstado.operadores);
+} // void mesclaEstadoBusca(const EstadoBuscaLocal &pEstado)
+
+/******************************************************************************
+* 	Function: avaliaPopulacaoParalela										  *
+*	Short Description: Population evaluator (GAPopulation::evaluator()) that *
+*					   runs Objective() for the genomes on the thread pool.	  *
+*					   Every genome starts from the local search state of the *
+*					   main thread and the results are merged in the order of *
+*					   the individuals, so the outcome does not depend on the *
+*					   number of threads.									  *
+*******************************************************************************/
+void avaliaPopulacaoParalela(GAPopulation &p)
+{
+    int intPrimeiro = 0;
+
+    // O genoma nulo da primeira geracao depende da ordem das chamadas: fica
+    // na thread principal
+    while (intPrimeiro < p.size() && primeira_geracao) {
+        p.individual(intPrimeiro++).evaluate();
+    }
+
+    if (intPrimeiro == p.size()) {
+        return;
+    }
+
+    EstadoBuscaLocal inicial;
+    vector<EstadoBuscaLocal> resultados(p.size() - intPrimeiro);
+    TarefaAvaliacao tarefa = { &p, intPrimeiro, &inicial, &resultados };
+
+    salvaEstadoBusca(inicial);
+    poolRun(resultados.size(), avaliaGenomaPool, &tarefa);
+
+    for (size_t r = 0; r < resultados.size(); r++) {
+        mesclaEstadoBusca(resultados[r]);
+    }
+} // void avaliaPopulacaoParalela(GAPopulation &p)
+
+// Com o pool ativo pela opcao -t, a populacao do AG passa a ser avaliada por
+// avaliaPopulacaoParalela(); sem ele, ou com -tv (pool nos lotes de vizinhos),
+// fica o avaliador padrao (serial)
+void configuraAvaliador(GAGeneticAlgorithm &ga)
+{
+    if (poolWorkers() > 0 && !bPoolVizinhanca) {
+        GAPopulation pop(ga.population());
+        pop.evaluator(avaliaPopulacaoParalela);
+        ga.population(pop);
+    }
+} // void configuraAvaliador(GAGeneticAlgorithm &ga)
+
+// Thread de uma ilha (GAThreadedDemeGA): contexto proprio e estado de busca
+// local inicial da thread principal ...
+void iniciaThreadIlha(int intIlha, void *pDados)
+{
+    preparaThreadAvaliacao();
+    restauraEstadoBusca(((EstadoIlhas *) pDados)->inicial);
+} // void iniciaThreadIlha(int intIlha, void *pDados)
+
+// ... e, ao terminar, o estado dela para a mescla em executaProblema()
+void terminaThreadIlha(int intIlha, void *pDados)
+{
+    salvaEstadoBusca(((EstadoIlhas *) pDados)->resultados[intIlha]);
+} // void terminaThreadIlha(int intIlha, void *pDados)
+
 /******************************************************************************
 * 	Function: Local Search (multiple seeds)                                    *
 *	Short Description:
@@ -2927,8 +2938,12 @@ void localSearch(const GAStatistics &g)
     vector<int> SS;
     vector<int> bestSeed;
     int val;
-    int P[MACHINE*JOB];
-    int bgn, fnl, pos, job, opr, maq, bgn2, fnl2, pos2, job2, opr2, maq2;
+    int pos, maq, pos2, maq2;
+    // Indices de posicoes de S[0] e de SS, e maquina/posicao das operacoes
+    // do caminho critico de SS
+    vector<int> posS0, posSS, maqCaminho, posCaminho;
+    vector<int> trocas;
+    indexaSemente(S[0], posS0);
     //
     //Faz uma busla local em cada um dos melhores indivduos
     //
@@ -2943,21 +2958,18 @@ void localSearch(const GAStatistics &g)
 
         // Copia S para uma estrutura temporaria que sofrer permutao
         SS = S[0];
+        posSS = posS0;
         // Permuta os valores de SS baseado no cromossomo gerado pelo AG
-        for(int i=0; i<genome.width(); i++)
+        listaTrocasGenoma(genome, trocas);
+        for (size_t t = 0; t < trocas.size(); t++)
         {
-            for(int j=0; j<genome.height(); j++)
-            {
-                if(genome.gene(i,j) == 1)
-                {
-                    val = SS[(j*JOB)+i];
-                    SS[(j*JOB)+i] = SS[(j*JOB)+i+1];
-                    SS[(j*JOB)+i+1] = val;
-                }
-            }
+            trocaSemente(SS, posSS, trocas[t], trocas[t]+1);
         }
         //
-        findCriticalPath(SS);
+        // Caminho critico, cabecas e caudas de SS (para estimar as trocas
+        // adjacentes) em uma so passada
+        bool cabecasValidas = (findCriticalPath(SS) < ITER);
+        indexaCaminhoCritico(posSS, maqCaminho, posCaminho);
         if(n == 0)
              bestSeed = SS;
 
@@ -2965,17 +2977,13 @@ void localSearch(const GAStatistics &g)
         // INICIA BUSCA LOCAL NA SEMENTE PERMUTADA PELO INDIVIDUO
         // BUSCA LOCAL COM BASE NO CAMINHO CRTICO DA SEMENTE PERMUTADA
         ////////////////////////////////////////////////////////////////////////
-        for(unsigned int i = 0; i < currentCriticalPath.size() - 2; i++) {
+        // Caminho vazio (SS nao factivel): size() - 2 daria a volta
+        for(unsigned int i = 0; i + 2 < currentCriticalPath.size(); i++) {
             ////////////////////////////////////////////////////////////////////////////
-            //identifica a i-sima operacao do caminho critico
-            job = (int) (currentCriticalPath[i]-1) / MACHINE; //0-index
-            opr = (int) ((currentCriticalPath[i]-1) - job*MACHINE); //0-index
-            // busca na matriz R quem  a maquina
-            maq = R[job * MACHINE + opr]; //1-index
-            // encontra posicao na semente
-            bgn = (maq - 1) * JOB;
-            fnl = bgn + (JOB - 1);
-            pos = std::find(SS.begin()+bgn, SS.begin()+fnl, (job+1)) - SS.begin();
+            //identifica a i-sima operacao do caminho critico: maquina
+            //(1-index) e posicao na semente
+            maq = maqCaminho[i];
+            pos = posCaminho[i];
 
             //cout << endl;
             //cout << currentCriticalPath[i] << "  " << job+1 << "  " << opr+1 << "  " << maq << endl;
@@ -2985,17 +2993,16 @@ void localSearch(const GAStatistics &g)
             // identifica todas as outras operacoes crticas da mesma maq
             for(unsigned int j = i+1; j < currentCriticalPath.size() - 1; j++) {
                 //
-                job2 = (int) (currentCriticalPath[j]-1) / MACHINE; //0-index
-                opr2 = (int) ((currentCriticalPath[j]-1) - job2*MACHINE); //0-index
-                // busca na matriz R quem  a maquina
-
-                maq2 = R[job2 * MACHINE + opr2]; //1-index
-                // encontra posicao na semente
-                bgn2 = (maq2 - 1) * JOB;
-                fnl2 = bgn2 + (JOB - 1);
-                pos2 = std::find(SS.begin()+bgn2, SS.begin()+fnl2, (job2+1)) - SS.begin();
+                maq2 = maqCaminho[j];
+                pos2 = posCaminho[j];
                 //
                 if(maq2  == maq){ //permuta
+                    // Troca adjacente: a estimativa nao passa do novo makespan,
+                    // entao a troca nao melhora se ela ja alcanca bestCurrent
+                    if(cabecasValidas && (pos2 == pos+1 || pos == pos2+1) &&
+                       estimaTroca(SS, min(pos, pos2)) >= bestCurrent) {
+                        continue;
+                    }
                     //
                     vector<int> newSS = SS;
                     val = newSS[pos];
@@ -3003,8 +3010,7 @@ void localSearch(const GAStatistics &g)
                     newSS[pos2] = val;
 
                     // Apenas o menor score interessa.
-                    AtualizarVetorComArray( P, newSS );
-                    score[0] = factivel(P,R,1,T);
+                    score[0] = avaliaSementeLimite(newSS, bestCurrent);
                     //
                     int fitness = (int) score[0];
                     ////////////////////////////////////////////////////
@@ -3034,6 +3040,175 @@ void localSearch(const GAStatistics &g)
     return;
  } // localSearch(const GAStatistics &g)
 
+/******************************************************************************
+* 	Function: tabuSearch													  *
+*	Short Description: Tabu search (Nowicki and Smutnicki) from the seed of  *
+*					   the best individual, in place of localSearch() after  *
+*					   the GA (option -tabu). The neighbourhood is N5 (see	  *
+*					   vizinhancaN5()). The moves are sorted by their O(1)	  *
+*					   lower bound (estimaTroca()) and evaluated exactly, with *
+*					   a cutoff, only while the bound can still beat the best *
+*					   neighbour found. The chosen one is applied and		  *
+*					   marcaBlocosCriticos() gives the heads, tails and		  *
+*					   critical blocks of the next iteration. The last		  *
+*					   TABUTENURE moves may not be undone unless that beats	  *
+*					   the best makespan (aspiration).						  *
+*					   Stops after intTabuIteracoes iterations, after		  *
+*					   dblTabuSegundos seconds (if > 0) or when N5 is empty	  *
+*					   (every critical operation is alone in its block, or	  *
+*					   its block opens and closes a critical path).			  *
+*******************************************************************************/
+void tabuSearch(const GAStatistics &g)
+{
+    vector<int> SS, posSS, melhorSemente, trocas, movimentos, vetBloco;
+    vector<char> vetExtremo;
+    vector< pair<int,int> > candidatos;	// (estimativa, posicao) de cada movimento
+    // Lista tabu circular: na maquina tabuMaq[k] o job tabuPrimeiro[k] nao
+    // pode voltar a ficar antes do job tabuSegundo[k]
+    vector<int> tabuMaq(TABUTENURE, -1), tabuPrimeiro(TABUTENURE, 0), tabuSegundo(TABUTENURE, 0);
+    int intProximoTabu = 0;
+    double dblInicio = clock();
+
+    // Semente do melhor individuo, como em localSearch()
+    GA2DBinaryStringGenome & genome = (GA2DBinaryStringGenome &)g.bestIndividual(0);
+    SS = S[0];
+    indexaSemente(SS, posSS);
+    listaTrocasGenoma(genome, trocas);
+    for (size_t t = 0; t < trocas.size(); t++) {
+        trocaSemente(SS, posSS, trocas[t], trocas[t]+1);
+    }
+
+    // Cabecas e caudas nos globais vetCabecas e vetCaudas (ver estimaTroca())
+    int intAtual = marcaBlocosCriticos(SS, vetBloco, vetExtremo, vetCabecas, vetCaudas);
+    int intMelhor = intAtual;
+    melhorSemente = SS;
+
+    for (int it = 0; it < intTabuIteracoes && intAtual < ITER; it++) {
+        if (dblTabuSegundos > 0 && (clock() - dblInicio)/CLOCKS_PER_SEC >= dblTabuSegundos) {
+            break;
+        }
+
+        vizinhancaN5(SS, vetBloco, vetCabecas, vetCaudas, movimentos);
+        if (movimentos.empty()) {
+            break;
+        }
+
+        // Estimativas dos movimentos, em ordem crescente; na primeira volta
+        // so os permitidos (nao tabu ou com aspiracao), na segunda, se todos
+        // forem tabu, qualquer um
+        candidatos.clear();
+        for (size_t m = 0; m < movimentos.size(); m++) {
+            int pos = movimentos[m];
+            candidatos.push_back(make_pair(estimaTroca(SS, pos), pos));
+        }
+        sort(candidatos.begin(), candidatos.end());
+
+        // Avaliacao exata so enquanto a estimativa (limite inferior) ainda
+        // pode bater o melhor vizinho, e com corte nele
+        int intEscolhido = -1, intValorEscolhido = ITER;
+
+        for (int volta = 0; volta < 2 && intEscolhido < 0; volta++) {
+            for (size_t m = 0; m < candidatos.size(); m++) {
+                int pos = candidatos[m].second;
+                if (candidatos[m].first >= intValorEscolhido) {
+                    break;
+                }
+
+                bool bTabu = false;
+                for (int k = 0; k < TABUTENURE && !bTabu && volta == 0; k++) {
+                    bTabu = (tabuMaq[k] == pos / JOB && tabuPrimeiro[k] == SS[pos] &&
+                             tabuSegundo[k] == SS[pos+1]);
+                }
+                if (bTabu && candidatos[m].first >= intMelhor) {
+                    continue; // tabu sem aspiracao
+                }
+
+                swap(SS[pos], SS[pos+1]);
+                int intValor = avaliaSementeLimite(SS, intValorEscolhido);
+                swap(SS[pos], SS[pos+1]);
+
+                if (bTabu && intValor >= intMelhor) {
+                    continue;
+                }
+                if (intValor < intValorEscolhido) {
+                    intEscolhido = pos;
+                    intValorEscolhido = intValor;
+                }
+            }
+        }
+        if (intEscolhido < 0) {
+            intEscolhido = candidatos[0].second;
+        }
+
+        // Desfazer a troca fica proibido: depois dela SS[pos+1] de agora
+        // passa a vir antes de SS[pos]
+        tabuMaq[intProximoTabu] = intEscolhido / JOB;
+        tabuPrimeiro[intProximoTabu] = SS[intEscolhido+1];
+        tabuSegundo[intProximoTabu] = SS[intEscolhido];
+        intProximoTabu = (intProximoTabu + 1) % TABUTENURE;
+
+        trocaSemente(SS, posSS, intEscolhido, intEscolhido+1);
+        intAtual = marcaBlocosCriticos(SS, vetBloco, vetExtremo, vetCabecas, vetCaudas);
+
+        if (intAtual < intMelhor) {
+            intMelhor = intAtual;
+            melhorSemente = SS;
+        }
+    }
+
+    if (intMelhor < bestCurrent) {
+        bestCurrent = intMelhor;
+        mostraMelhoria(intMelhor);
+    }
+
+    // currentCriticalPath, vetCabecas e vetCaudas de volta na semente devolvida
+    findCriticalPath(melhorSemente);
+
+    S[0] = melhorSemente;
+    bestSeedBuscaLocal = melhorSemente;
+} // void tabuSearch(const GAStatistics &g)
+
+// Vizinhanca N5 dos blocos criticos de pSemente (pBloco, pCabecas e pCaudas
+// de marcaBlocosCriticos()): em cada bloco de duas ou mais operacoes a troca
+// do primeiro par e a do ultimo, menos o primeiro par quando o bloco abre um
+// caminho critico (cabeca 0) e o ultimo quando o fecha (cauda 0).
+// pMovimentos recebe a posicao pos de cada troca (pos e pos+1 na semente).
+void vizinhancaN5(const vector<int> &pSemente, const vector<int> &pBloco, const vector<int> &pCabecas,
+                  const vector<int> &pCaudas, vector<int> &pMovimentos)
+{
+    pMovimentos.clear();
+
+    for (int m = 0; m < MACHINE; m++) {
+        int intInicio = m*JOB;
+
+        while (intInicio < (m+1)*JOB) {
+            int intFim = intInicio;
+            while (pBloco[intInicio] != 0 && intFim + 1 < (m+1)*JOB &&
+                   pBloco[intFim+1] == pBloco[intInicio]) {
+                intFim++;
+            }
+
+            if (intFim > intInicio) {
+                int intJob = pSemente[intInicio] - 1;
+                int opInicio = intJob*MACHINE + ctxAvaliacao.opmachine[intJob*MACHINE + m];
+                intJob = pSemente[intFim] - 1;
+                int opFim = intJob*MACHINE + ctxAvaliacao.opmachine[intJob*MACHINE + m];
+
+                bool bPrimeiro = (pCabecas[opInicio] > 0);
+                if (bPrimeiro) {
+                    pMovimentos.push_back(intInicio);
+                }
+                // Bloco de dois: o ultimo par e o primeiro
+                if (pCaudas[opFim] > 0 && (intFim - intInicio > 1 || !bPrimeiro)) {
+                    pMovimentos.push_back(intFim - 1);
+                }
+            }
+
+            intInicio = intFim + 1;
+        }
+    }
+} // void vizinhancaN5(...)
+
 /******************************************************************************
 * 	Function: Local Search	(single seed)									  *
 *	Short Description:
@@ -3048,8 +3223,10 @@ void localSearch()
     //        unsigned int i, j;
     int maq, maq2, pos, pos2;
     vector<int> bestInitialSeed;
+    // Indice de posicoes de SS e maquina/posicao das operacoes do caminho
+    // critico de SS
+    vector<int> posSS, maqCaminho, posCaminho;
 
-    int P[MACHINE*JOB];
 
     /////////////////////////////////////////////
     /// Permuta semente e calcula aptidao
@@ -3061,22 +3238,21 @@ void localSearch()
     while(melhora){
         // Copia S para uma estrutura temporaria que sofrer permutao
         SS = S[0];
-        findCriticalPath(SS);
+        // Caminho critico, cabecas e caudas de SS (para estimar as trocas
+        // adjacentes) em uma so passada
+        bool cabecasValidas = (findCriticalPath(SS) < ITER);
+        indexaSemente(SS, posSS);
+        indexaCaminhoCritico(posSS, maqCaminho, posCaminho);
         melhora = false;
 
         //cout << "*" << currentCriticalPath.size() << endl;
         //getchar();
-        for(unsigned int i = 0; i < currentCriticalPath.size() - 1; i++) {
+        for(unsigned int i = 0; i + 1 < currentCriticalPath.size(); i++) {
             ////////////////////////////////////////////////////////////////
-            //identifica a i-sima operacao do caminho critico
-            int job = (int) (currentCriticalPath[i]-1) / MACHINE; //0-index
-            int opr = (int) ((currentCriticalPath[i]-1) - job*MACHINE); //0-index
-            // busca na matriz R quem  a maquina
-            maq = R[job * MACHINE + opr]; //1-index
-            // encontra posicao na semente
-            int bgn = (maq - 1) * JOB;
-            int fnl = bgn + (JOB - 1);
-            pos = std::find(SS.begin()+bgn, SS.begin()+fnl, (job+1)) - SS.begin();
+            //identifica a i-sima operacao do caminho critico: maquina
+            //(1-index) e posicao na semente
+            maq = maqCaminho[i];
+            pos = posCaminho[i];
 
             //cout << endl;
             //cout << currentCriticalPath[i] << "  " << job+1 << "  " << opr+1 << "  " << maq << endl;
@@ -3085,16 +3261,16 @@ void localSearch()
             ////////////////////////////////////////////////////////////////
             // identifica todas as outras operacoes crticas da mesma maq
             for(unsigned int j = i+1; j < currentCriticalPath.size() - 1; j++) {
-                int job2 = (int) (currentCriticalPath[j]-1) / MACHINE; //0-index
-                int opr2 = (int) ((currentCriticalPath[j]-1) - job2*MACHINE); //0-index
-                // busca na matriz R quem  a maquina
-                maq2 = R[job2 * MACHINE + opr2]; //1-index
-                // encontra posicao na semente
-                int bgn2 = (maq2 - 1) * JOB;
-                int fnl2 = bgn2 + (JOB - 1);
-                pos2 = std::find(SS.begin()+bgn2, SS.begin()+fnl2, (job2+1)) - SS.begin();
+                maq2 = maqCaminho[j];
+                pos2 = posCaminho[j];
 
                 if(maq  == maq2){ //permuta
+                    // Troca adjacente: a estimativa nao passa do novo makespan,
+                    // entao a troca nao melhora se ela ja alcanca bestCurrent
+                    if(cabecasValidas && (pos2 == pos+1 || pos == pos2+1) &&
+                       estimaTroca(SS, min(pos, pos2)) >= bestCurrent) {
+                        continue;
+                    }
                     //
                     vector<int> newSS = SS;
                     val = newSS[pos];
@@ -3102,8 +3278,7 @@ void localSearch()
                     newSS[pos2] = val;
 
                     // Apenas o menor score interessa.
-                    AtualizarVetorComArray( P, newSS );
-                    score[0] = factivel(P,R,1,T);
+                    score[0] = avaliaSementeLimite(newSS, bestCurrent);
                     //
                     int fitness = score[0];
                     //cout << endl << scoreTopList[0] << " " << fitness << endl;
@@ -3117,7 +3292,7 @@ void localSearch()
                     }
                 } // if(maq  == maq2){ //permuta
             } // for(unsigned int j = i+1; j < currentCriticalPath.size() - 1; j++) {
-        } // for(unsigned int i = 0; i < currentCriticalPath.size() - 1; i++) {
+        } // for(unsigned int i = 0; i + 1 < currentCriticalPath.size(); i++) {
 
         if(melhora == true) {
             S[0] = bestInitialSeed;
@@ -3159,6 +3334,7 @@ void cpBasedSeedGA()
         ga.pConvergence(1);
         ga.nConvergence((int)MACHINE*JOB/5);
         ga.terminator(GAGeneticAlgorithm::TerminateUponConvergence);
+        configuraAvaliador(ga);
 
         primeira_geracao=true;
         cpBasedSeed = true;
@@ -3524,12 +3700,15 @@ int localSearch4(GAGenome& g, int originalScore)
 //===============Algoritmo de Permutao=================
 void permutacao(vector<int> vet, int originalScore)
 {
-    int P[MACHINE*JOB];
     int bestScore = 0;
     int score = 0;
     bool melhorou = false;
     //Armazena as possveis solues gerados pela permutacao.
     vector<int> SSS;
+    // Blocos criticos de vet (ver marcaBlocosCriticos())
+    static thread_local vector<int> vetBloco, cabecas, caudas;
+    static thread_local vector<char> vetExtremo;
+    bool bFiltra = false;
 
     if(bestScorePermutacao <= originalScore && bestScorePermutacao > 0){
         bestScore = bestScorePermutacao;
@@ -3539,11 +3718,21 @@ void permutacao(vector<int> vet, int originalScore)
     }
 
     //Delimita o intervalo das maquinas
-    for(size_t i = 0; i < MACHINE; i++){
-        if(melhorou == true){
-            vet = listaSolucaoPermutacao;
+    for(size_t i = 0; i < (size_t) MACHINE; i++){
+        if(melhorou == true || i == 0){
+            if(i > 0) vet = listaSolucaoPermutacao;
             melhorou = false;
+            // As trocas em sequencia levam a operacao k para a posicao j
+            // (j..k-1 andam uma casa). Se a operacao k nao for critica, ou se
+            // j e k forem do meio do mesmo bloco, o caminho critico continua
+            // la (no maximo com k a mais) e o makespan nao pode diminuir.
+            // Sem caminho (semente nao factivel) gera todos.
+            bFiltra = !bPermutacaoCompleta &&
+                      marcaBlocosCriticos(vet, vetBloco, vetExtremo, cabecas, caudas) < ITER;
         }
+        // Gera todas as permutacoes da maquina no lote antes de avaliar
+        loteLimpa(loteVizinhos);
+
         //Delimita o intervalo dos jobs dentro das maquinas
         for(size_t j = (i*JOB); j < (JOB*(i+1)); j++){
             SSS = vet;
@@ -3553,21 +3742,29 @@ void permutacao(vector<int> vet, int originalScore)
                 SSS[j] = SSS[k] - SSS[j];
                 SSS[k] -= SSS[j];
 
-                // Apenas o menor score interessa.
-                AtualizarVetorComArray( P, SSS );
+                if(bFiltra && (vetBloco[k] == 0 ||
+                   (vetBloco[j] == vetBloco[k] && !vetExtremo[j] && !vetExtremo[k]))){
+                    continue;
+                }
+                loteAdiciona(loteVizinhos, SSS);
+            }
+        }
+
+        // Apenas o menor score interessa.
+        loteAvalia(loteVizinhos, bestScore);
 
-                score = factivel(P,R,1,T);
+        for(int c = 0; c < loteVizinhos.intQuantidade; c++){
+            score = loteVizinhos.vetMakespans[c];
 
-                // Encontra as solues factiveis
-                    if (score < ITER) {
-                        //Verifica se a soluo encontrada  melhor que a anterior
-                        if(score < bestScore){
-                        //Atualizar a soluo e o score encontrado
-                        melhorou = true;
-                        bestScore = score;
-                        listaSolucaoPermutacao = SSS;
-                        printf("\nSolucao melhor: %d", score);
-                    }
+            // Encontra as solues factiveis
+            if (score < ITER) {
+                //Verifica se a soluo encontrada  melhor que a anterior
+                if(score < bestScore){
+                    //Atualizar a soluo e o score encontrado
+                    melhorou = true;
+                    bestScore = score;
+                    loteSemente(loteVizinhos, c, listaSolucaoPermutacao);
+                    mostraMelhoria(score);
                 }
             }
         }
@@ -3578,14 +3775,22 @@ void permutacao(vector<int> vet, int originalScore)
 }
 //=======================================================
 //=============Algoritmo de Insero======================
+// Leva cada operacao critica de vet para qualquer outra posicao da sua
+// maquina (as do meio andam uma casa). Os movimentos sao ordenados pela
+// estimativa de cabecas e caudas (estimaInsercao()) e so os INSERCAOEXATOS
+// melhores de cada maquina sao avaliados de fato.
 void insercao(vector<int> vet, int originalScore)
 {
-    int P[MACHINE*JOB];
     int bestScore = 0;
     int score = 0;
     bool melhorou = false;
     //Armazena as possveis solues gerados pela insercao
     vector<int> SSS;
+    // Blocos criticos, cabecas e caudas de vet (ver marcaBlocosCriticos())
+    static thread_local vector<int> vetBloco, cabecas, caudas;
+    static thread_local vector<char> vetExtremo;
+    // (estimativa, de*MACHINE*JOB + para) de cada insercao da maquina
+    static thread_local vector< pair<int,int> > candidatos;
 
     if(bestScoreInsercao <= originalScore && bestScoreInsercao > 0)
         bestScore = bestScoreInsercao;
@@ -3594,63 +3799,64 @@ void insercao(vector<int> vet, int originalScore)
         bestScoreInsercao = originalScore;
     }
 
-        for(size_t m = 0; m < MACHINE; m++){
-            if(melhorou == true){
-                vet = listaSolucaoInsercao;
+        for(int m = 0; m < MACHINE; m++){
+            if(melhorou == true || m == 0){
+                if(m > 0) vet = listaSolucaoInsercao;
                 melhorou = false;
+                // Sem cabecas e caudas (semente nao factivel) nao ha estimativa
+                if(marcaBlocosCriticos(vet, vetBloco, vetExtremo, cabecas, caudas) >= ITER)
+                    break;
             }
-            for(size_t j = (m*JOB); j < (JOB*(m+1)); j++){
-                SSS = vet;
-                //verifica se o j est fora da janela
-                if(j < (startWindow + (m*JOB))){
-                    for(size_t idx = j+1; idx <= finalWindow + (m*JOB); idx++){
-                        SSS[idx-1] += SSS[idx];
-                        SSS[idx] = SSS[idx-1] - SSS[idx];
-                        SSS[idx-1] -= SSS[idx];
-                    }
 
-                    // Apenas o menor score interessa.
-                    AtualizarVetorComArray( P, SSS );
-
-                    score = factivel(P,R,1,T);
-
-                    // Encontra as solues factiveis
-                    if (score < ITER) {
-                        //Verifica se a soluo encontrada  melhor que a anterior
-                        if(score < bestScore){
-                            //Atualizar a soluo e o score encontrado
-                            melhorou = true;
-                            bestScore = score;
-                            listaSolucaoInsercao = SSS;
-                            printf("\nSolucao melhor: %d", score);
-                        }
-                    }
+            // Insercoes de operacoes criticas que a estimativa deixa abaixo
+            // do melhor score
+            candidatos.clear();
+            for(int de = m*JOB; de < (m+1)*JOB; de++){
+                if(vetBloco[de] == 0)
+                    continue;
+                for(int para = m*JOB; para < (m+1)*JOB; para++){
+                    if(para == de)
+                        continue;
+                    int intEstimativa = estimaInsercao(vet, cabecas, caudas, de, para);
+                    if(intEstimativa < bestScore)
+                        candidatos.push_back(make_pair(intEstimativa, de*MACHINE*JOB + para));
                 }
-                //verifica se o j est fora da janela
-                else {
-                    if(j > (finalWindow + (m*JOB))){
-                        for(size_t idx = (JOB + (m*JOB))-1; idx >= startWindow + (m*JOB); idx--){
-                            SSS[idx-1] += SSS[idx];
-                            SSS[idx] = SSS[idx-1] - SSS[idx];
-                            SSS[idx-1] -= SSS[idx];
-                        }
+            }
 
-                        // Apenas o menor score interessa.
-                        AtualizarVetorComArray( P, SSS );
-
-                        score = factivel(P,R,1,T);
-
-                        // Encontra as solues factiveis
-                        if (score < ITER) {
-                            //Verifica se a soluo encontrada  melhor que a anterior
-                            if(score < bestScore){
-                                //Atualizar a soluo e o score encontrado
-                                melhorou = true;
-                                bestScore = score;
-                                listaSolucaoInsercao = SSS;
-                                printf("\nSolucao melhor: %d", score);
-                            }
-                        }
+            int intExatos = min((int) candidatos.size(), INSERCAOEXATOS);
+            partial_sort(candidatos.begin(), candidatos.begin() + intExatos, candidatos.end());
+
+            // Gera as melhores insercoes da maquina no lote antes de avaliar
+            loteLimpa(loteVizinhos);
+
+            for(int c = 0; c < intExatos; c++){
+                int de = candidatos[c].second / (MACHINE*JOB);
+                int para = candidatos[c].second % (MACHINE*JOB);
+
+                SSS = vet;
+                if(de < para)
+                    rotate(SSS.begin() + de, SSS.begin() + de + 1, SSS.begin() + para + 1);
+                else
+                    rotate(SSS.begin() + para, SSS.begin() + de, SSS.begin() + de + 1);
+
+                loteAdiciona(loteVizinhos, SSS);
+            }
+
+            // Apenas o menor score interessa.
+            loteAvalia(loteVizinhos, bestScore);
+
+            for(int c = 0; c < loteVizinhos.intQuantidade; c++){
+                score = loteVizinhos.vetMakespans[c];
+
+                // Encontra as solues factiveis
+                if (score < ITER) {
+                    //Verifica se a soluo encontrada  melhor que a anterior
+                    if(score < bestScore){
+                        //Atualizar a soluo e o score encontrado
+                        melhorou = true;
+                        bestScore = score;
+                        loteSemente(loteVizinhos, c, listaSolucaoInsercao);
+                        mostraMelhoria(score);
                     }
                 }
             }
@@ -3660,53 +3866,131 @@ void insercao(vector<int> vet, int originalScore)
             bestScoreInsercao = bestScore;
         }
 }
-//=======================================================
-//Verifica se o intervalo da janela est ok.
-void entrarInsercao(vector<int> SS, int originalScore){
-    if((startWindow >= 0 && startWindow < JOB) && (finalWindow > 0 && finalWindow < JOB)){
-        insercao(SS, originalScore);
+
+// Registra uma chamada do operador intOperador: os valores descontados de
+// todos os operadores perdem peso e os dele recebem a chamada
+void registraOperador(int intOperador, int intGanho, long lngAvaliacoes, double dblMilissegundos)
+{
+    for (int k = 0; k < NOPERADORES; k++) {
+        vetOperadores[k].dblGanho *= OPERADORDESCONTO;
+        vetOperadores[k].dblAvaliacoes *= OPERADORDESCONTO;
+        vetOperadores[k].dblChamadas *= OPERADORDESCONTO;
     }
-    else{
-        char resp;
-        cout << "O intervalo da janela esta fora do tamanho do vetor" << endl;
-        cout << "Tamanho janela - Inicio: " << startWindow << " - Final: " << finalWindow << endl;
-        cout << "Tamanho do espaco de procura - inicio: 0" << " - Final: " << JOB << endl;
-        cout << "Deseja informar indice da janela manualmente?: S ou N: ";
-        cin >> resp;
-        if(resp == 's' || resp == 'S'){
-            cout << "informe o inicio da janela(indice) entre 0 e " << JOB << " : ";
-            cin >> startWindow;
-            cout << "Informe o final da janela(indice) : ";
-            cin >> finalWindow;
-
-            cout << "========Janela gerada=======" << endl;
-            cout << "Inicio (indice): " << startWindow << ", Final(indice): " << finalWindow << endl;
-
-            insercao(SS, originalScore);
+
+    EstatisticaOperador &op = vetOperadores[intOperador];
+    op.dblGanho += intGanho;
+    op.dblAvaliacoes += lngAvaliacoes;
+    op.dblChamadas += 1;
+    op.lngChamadas++;
+    op.lngMelhorias += (intGanho > 0);
+    op.lngGanho += intGanho;
+    op.lngAvaliacoes += lngAvaliacoes;
+    op.dblMilissegundos += dblMilissegundos;
+} // void registraOperador(...)
+
+// UCB descontado: ganho por semente avaliada na janela (relativo ao do
+// melhor operador) mais um bonus para quem foi pouco usado nela. Quem nunca
+// rodou vai primeiro; sem ganho na janela, os operadores se revezam.
+int escolheOperador()
+{
+    double dblTaxa[NOPERADORES], dblMelhorTaxa = 0, dblTotal = 0;
+
+    for (int k = 0; k < NOPERADORES; k++) {
+        if (vetOperadores[k].dblChamadas == 0) {
+            return k;
         }
-        else{
-            cout << "Uma nova janela sera gerada automaticamente." << endl;
+        dblTaxa[k] = vetOperadores[k].dblGanho / max(vetOperadores[k].dblAvaliacoes, 1.0);
+        dblMelhorTaxa = max(dblMelhorTaxa, dblTaxa[k]);
+        dblTotal += vetOperadores[k].dblChamadas;
+    }
 
-            startWindow = rand() % ((JOB/2) + 1); //Gera numero aleatoria de 1 a metade no numero de JOBs
-            finalWindow = rand() % (startWindow + ((JOB/2)) + 1); //Gera numero aleatoria entre a janela inicial mais metade
+    int intEscolhido = 0;
+    double dblMelhorValor = -1;
 
-            cout << "========Nova Janela gerada========" << endl;
-            cout << "Inicio (indice): " << startWindow << ", Final(indice): " << finalWindow << endl;
-            cout << "===================================" << endl;
-            //Chama a funcao insercao j com a nova janela gerada.
-            //getchar();
-            //getchar();
+    for (int k = 0; k < NOPERADORES; k++) {
+        double dblValor = (dblMelhorTaxa > 0 ? dblTaxa[k] / dblMelhorTaxa : 0) +
+            OPERADOREXPLORACAO * sqrt(log(max(dblTotal, 1.0)) / vetOperadores[k].dblChamadas);
+        if (dblValor > dblMelhorValor) {
+            dblMelhorValor = dblValor;
+            intEscolhido = k;
+        }
+    }
 
-            insercao(SS, originalScore);
-            }
+    return intEscolhido;
+} // int escolheOperador()
+
+// Roda um operador de busca local sobre a semente e registra quanto ele
+// baixou o melhor score das buscas locais (ou o da semente, se menor), com
+// quantas sementes avaliou e em quanto tempo
+void executaOperador(int intOperador, const vector<int> &pSemente, int intScore)
+{
+    int *vetMelhores[NOPERADORES] = {&bestScorePermutacao, &bestScoreInsercao, &bestScoreInsercaoCompleta};
+    int intReferencia = intScore;
+
+    for (int k = 0; k < NOPERADORES; k++) {
+        if (*vetMelhores[k] > 0 && *vetMelhores[k] < intReferencia) {
+            intReferencia = *vetMelhores[k];
         }
     }
 
+    unsigned long lngAntes = ctxAvaliacao.iCacheHits + ctxAvaliacao.iCacheMisses;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+    if (intOperador == 0) {
+        permutacao(pSemente, intScore);
+    } else if (intOperador == 1) {
+        insercao(pSemente, intScore);
+    } else {
+        insercaoCompleta(pSemente, intScore);
+    }
+
+    double dblMilissegundos = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+
+    // Sair de uma semente nao factivel nao conta como ganho de makespan
+    int intGanho = intReferencia < ITER ? max(intReferencia - *vetMelhores[intOperador], 0) : 0;
+
+    registraOperador(intOperador, intGanho,
+                     ctxAvaliacao.iCacheHits + ctxAvaliacao.iCacheMisses - lngAntes, dblMilissegundos);
+} // void executaOperador(...)
+
+// Mescla na thread principal o que uma thread auxiliar registrou: as
+// chamadas dela entram de uma vez nos valores descontados, na ordem da mescla
+void mesclaOperadores(const EstatisticaOperador *pOperadores)
+{
+    long lngChamadas = 0;
+
+    for (int k = 0; k < NOPERADORES; k++) {
+        lngChamadas += pOperadores[k].lngChamadas;
+    }
+    double dblFator = pow(OPERADORDESCONTO, (double) lngChamadas);
+
+    for (int k = 0; k < NOPERADORES; k++) {
+        EstatisticaOperador &op = vetOperadores[k];
+        const EstatisticaOperador &novo = pOperadores[k];
+
+        op.dblGanho = op.dblGanho * dblFator + novo.lngGanho;
+        op.dblAvaliacoes = op.dblAvaliacoes * dblFator + novo.lngAvaliacoes;
+        op.dblChamadas = op.dblChamadas * dblFator + novo.lngChamadas;
+        op.lngChamadas += novo.lngChamadas;
+        op.lngMelhorias += novo.lngMelhorias;
+        op.lngGanho += novo.lngGanho;
+        op.lngAvaliacoes += novo.lngAvaliacoes;
+        op.dblMilissegundos += novo.dblMilissegundos;
+    }
+} // void mesclaOperadores(const EstatisticaOperador *pOperadores)
+
+// Melhoria encontrada por uma busca local. Nas threads do pool nao imprime:
+// avaliaPopulacaoParalela() imprime as melhorias ao mesclar os resultados.
+void mostraMelhoria(int score){
+    if(!threadAuxiliar){
+        printf("\nSolucao melhor: %d", score);
+    }
+}
+
 
 //=============Algoritmo de Insero======================
 void insercaoCompleta(vector<int> vet, int originalScore)
 {
-    int P[MACHINE*JOB];
     int bestScore = 0;
     int score = 0;
     bool melhorou = false;
@@ -3722,7 +4006,7 @@ void insercaoCompleta(vector<int> vet, int originalScore)
         bestScoreInsercaoCompleta = originalScore;
     }
 
-    for(size_t m = 0; m < MACHINE; m++){
+    for(size_t m = 0; m < (size_t) MACHINE; m++){
         if(melhorou == true){
             vet = listaSolucaoInsercaoCompleta;
             melhorou = false;
@@ -3730,6 +4014,9 @@ void insercaoCompleta(vector<int> vet, int originalScore)
         SSS = vet;
         Si = (Sj = JOB*(m+1) - 1) - 1;
 
+        // Gera as insercoes da maquina no lote antes de avaliar
+        loteLimpa(loteVizinhos);
+
         for(size_t idx = ((m+1)*JOB) - 1; idx > ((Sj-Si)+1); idx--){
             SSS[Si] += SSS[idx-2];
             SSS[idx-2] = SSS[Si] - SSS[idx-2];
@@ -3742,18 +4029,22 @@ void insercaoCompleta(vector<int> vet, int originalScore)
             Si -= 1;
             Sj -= 1;
 
-            // Apenas o menor score interessa.
-            AtualizarVetorComArray( P, SSS );
+            loteAdiciona(loteVizinhos, SSS);
+        }
+
+        // Apenas o menor score interessa.
+        loteAvalia(loteVizinhos, bestScore);
 
-            score = factivel(P,R,1,T);
+        for(int c = 0; c < loteVizinhos.intQuantidade; c++){
+            score = loteVizinhos.vetMakespans[c];
 
             // Encontra as soluoes factiveis
             if (score < ITER) {
                 if(score < bestScore){
                     melhorou = true;
                     bestScore = score;
-                    listaSolucaoInsercaoCompleta = SSS;
-                    printf("\nSolucao melhor: %d", score);
+                    loteSemente(loteVizinhos, c, listaSolucaoInsercaoCompleta);
+                    mostraMelhoria(score);
                 }
             }
         }
@@ -0,0 +1,406 @@
+/******************************************************************************
+* 	Scheduling_deme.cpp														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+*																			  *
+*	Short Description: Island model with one thread per deme and			  *
+*					   asynchronous migration (GAThreadedDemeGA).			  *
+******************************************************************************/
+
+#include "Scheduling_deme.h"
+
+#include <ga/garandom.h>
+
+#define MIGRANTROUNDS	4		/* migrações que cabem em uma fila */
+
+MigrantQueue::MigrantQueue(unsigned int iCapacity) : head(0), tail(0){
+
+	unsigned int n = 2;
+
+	while(n<iCapacity) n <<= 1;
+
+	ring.assign(n, (GAGenome *) 0);
+	mask = n - 1;
+}
+
+MigrantQueue::~MigrantQueue(){
+
+	GAGenome *g;
+
+	while((g = pop())!=0)
+		delete g;
+}
+
+// Só a ilha de origem escreve em tail e só a de destino escreve em head
+bool MigrantQueue::push(GAGenome *g){
+
+	unsigned int t = tail.load(std::memory_order_relaxed);
+
+	if(t - head.load(std::memory_order_acquire) > mask) return false;
+
+	ring[t & mask] = g;
+	tail.store(t + 1, std::memory_order_release);
+
+	return true;
+}
+
+GAGenome * MigrantQueue::pop(){
+
+	unsigned int h = head.load(std::memory_order_relaxed);
+	GAGenome *g;
+
+	if(h==tail.load(std::memory_order_acquire)) return 0;
+
+	g = ring[h & mask];
+	head.store(h + 1, std::memory_order_release);
+
+	return g;
+}
+
+GAThreadedDemeGA::GAThreadedDemeGA(const GAGenome &c) : GADemeGA(c), stopping(false){
+
+	interval = 1;
+	topo = RING;
+	ringstep = 1;
+	hookstart = hookend = 0;
+	hookdata = 0;
+	aggregated = 0;
+}
+
+GAThreadedDemeGA::~GAThreadedDemeGA(){
+
+	size_t i;
+
+	release();
+
+	for(i=0;i<tmpdeme.size();i++)
+		delete tmpdeme[i];
+	for(i=0;i<slots.size();i++){
+		delete slots[i]->best;
+		delete slots[i];
+	}
+	freeMigrants();
+}
+
+// Mesma inicialização de GADemeGA, mais a população temporária, o resumo
+// publicado, as filas de entrada e de devolução e os genomas livres de cada
+// ilha
+void GAThreadedDemeGA::initialize(unsigned int seed){
+
+	unsigned int ii;
+	size_t i;
+
+	release();
+	GADemeGA::initialize(seed);
+
+	for(i=0;i<tmpdeme.size();i++)
+		delete tmpdeme[i];
+	for(i=0;i<slots.size();i++){
+		delete slots[i]->best;
+		delete slots[i];
+	}
+	freeMigrants();
+
+	tmpdeme.assign(npop, (GAPopulation *) 0);
+	slots.assign(npop, (DemeSlot *) 0);
+	inbox.assign(2*npop, (MigrantQueue *) 0);
+	recycle.assign(2*npop, (MigrantQueue *) 0);
+	spare.assign(npop, std::vector<GAGenome *>());
+
+	for(ii=0;ii<npop;ii++){
+		tmpdeme[ii] = new GAPopulation(deme[ii]->individual(0), nrepl[ii]);
+		tmpdeme[ii]->order(deme[ii]->order());
+		deme[ii]->reserve(deme[ii]->size() + nrepl[ii]);	// evolveDeme() soma tmpdeme antes de tirar os piores
+
+		slots[ii] = new DemeSlot;
+		slots[ii]->best = deme[ii]->best().clone();
+		slots[ii]->generation = 0;
+		slots[ii]->running = false;
+
+		inbox[2*ii] = new MigrantQueue(MIGRANTROUNDS*nmig);
+		inbox[2*ii+1] = new MigrantQueue(MIGRANTROUNDS*nmig);
+		recycle[2*ii] = new MigrantQueue(MIGRANTROUNDS*nmig);
+		recycle[2*ii+1] = new MigrantQueue(MIGRANTROUNDS*nmig);
+		spare[ii].reserve(4*MIGRANTROUNDS*nmig);
+	}
+
+	aggregated = 0;
+}
+
+// Uma geração global: na primeira chamada dispara as ilhas; depois espera
+// que todas passem da última geração agregada (as que andam na frente
+// seguem andando) e atualiza as estatísticas com os melhores publicados
+void GAThreadedDemeGA::step(){
+
+	unsigned int ii;
+	bool progress = false;
+
+	if(slots.size()!=npop) initialize();
+
+	if(threads.empty()){
+		stopping = false;
+		for(ii=0;ii<npop;ii++){
+			slots[ii]->generation = aggregated;
+			slots[ii]->running = true;
+		}
+
+		// Semente de cada partida tirada do gerador principal e um fluxo
+		// dela por ilha (GARandomSeedStream). Só as sequências aleatórias
+		// se repetem com GARandomSeed(): a migração é assíncrona (quando
+		// um migrante chega depende do ritmo das threads, e com a fila
+		// cheia ele é descartado), então a execução não é reproduzível
+		for(ii=0;ii<npop;ii++)
+			threads.push_back(std::thread(&GAThreadedDemeGA::run, this, ii,
+										  (unsigned int) GARandomInt(1, 0x7FFFFFFF)));
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mtxDone);
+		cvDone.wait(lock, [&]{
+			for(unsigned int k=0;k<npop;k++){
+				std::lock_guard<std::mutex> lockslot(slots[k]->mtx);
+				if(slots[k]->running && slots[k]->generation<=aggregated) return false;
+			}
+			return true;
+		});
+	}
+
+	stats.numsel = stats.numcro = stats.nummut = stats.numrep = stats.numeval = 0;
+	unsigned long numpeval = 0;
+
+	for(ii=0;ii<npop;ii++){
+		std::lock_guard<std::mutex> lock(slots[ii]->mtx);
+
+		if(slots[ii]->generation>aggregated) progress = true;
+
+		pop->individual(ii).copy(*slots[ii]->best);
+		stats.numsel += slots[ii]->numsel;
+		stats.numcro += slots[ii]->numcro;
+		stats.nummut += slots[ii]->nummut;
+		stats.numrep += slots[ii]->numrep;
+		stats.numeval += slots[ii]->numeval;
+		numpeval += slots[ii]->numpeval;
+	}
+
+	// Todas as ilhas terminaram sem geração nova: nada a agregar
+	if(!progress){
+		release();
+		return;
+	}
+
+	aggregated++;
+	pop->touch();
+	stats.update(*pop);
+	stats.numpeval += numpeval;
+
+	if(done()) release();
+}
+
+// Para as ilhas (cada uma termina a geração em curso) e espera as threads
+void GAThreadedDemeGA::stop(){
+
+	release();
+}
+
+void GAThreadedDemeGA::release(){
+
+	size_t i;
+
+	if(threads.empty()) return;
+
+	stopping = true;
+	for(i=0;i<threads.size();i++)
+		threads[i].join();
+	threads.clear();
+
+	// Migrantes que ficaram nas filas viram genomas livres da ilha de
+	// destino (as threads já terminaram)
+	for(i=0;i<inbox.size();i++){
+		GAGenome *g;
+		while((g = inbox[i]->pop())!=0)
+			spare[i/2].push_back(g);
+	}
+}
+
+// Filas de migração e genomas livres, com os genomas que estiverem nelas
+void GAThreadedDemeGA::freeMigrants(){
+
+	size_t i, j;
+
+	for(i=0;i<inbox.size();i++)
+		delete inbox[i];
+	for(i=0;i<recycle.size();i++)
+		delete recycle[i];
+	for(i=0;i<spare.size();i++)
+		for(j=0;j<spare[i].size();j++)
+			delete spare[i][j];
+
+	inbox.clear();
+	recycle.clear();
+	spare.clear();
+}
+
+// Laço da thread da ilha ii
+void GAThreadedDemeGA::run(unsigned int ii, unsigned int seed){
+
+	int gen = aggregated;
+
+	GARandomSeedStream(seed, ii+1);
+	if(hookstart) hookstart(ii, hookdata);
+
+	while(!stopping){
+		if(terminator()==GAGeneticAlgorithm::TerminateUponGeneration && gen>=nGenerations())
+			break;
+
+		evolveDeme(ii);
+		gen++;
+
+		if(gen % interval==0) emigrate(ii);
+		immigrate(ii);
+
+		deme[ii]->evaluate();
+		pstats[ii].update(*deme[ii]);
+
+		publish(ii, gen);
+	}
+
+	if(hookend) hookend(ii, hookdata);
+
+	{
+		std::lock_guard<std::mutex> lock(slots[ii]->mtx);
+		slots[ii]->running = false;
+	}
+	std::lock_guard<std::mutex> lock(mtxDone);
+	cvDone.notify_all();
+}
+
+// Uma geração da ilha ii, como no laço de GADemeGA::step(), com a
+// população temporária da própria ilha
+void GAThreadedDemeGA::evolveDeme(unsigned int ii){
+
+	int i, mut, c1, c2;
+	GAGenome *mom, *dad;
+	GAPopulation *tmppop = tmpdeme[ii];
+	float pc;
+
+	if(!scross) pc = 0.0;
+	else        pc = pCrossover();
+
+	for(i=0; i<nrepl[ii]-1; i+=2){
+		mom = &(deme[ii]->select());
+		dad = &(deme[ii]->select());
+		pstats[ii].numsel += 2;
+		c1 = c2 = 0;
+		if(GAFlipCoin(pc)){
+			pstats[ii].numcro += (*scross)(*mom, *dad, &tmppop->individual(i),
+										   &tmppop->individual(i+1));
+			c1 = c2 = 1;
+		}
+		else{
+			tmppop->individual( i ).copy(*mom);
+			tmppop->individual(i+1).copy(*dad);
+		}
+		pstats[ii].nummut += (mut=tmppop->individual( i ).mutate(pMutation()));
+		if(mut > 0) c1 = 1;
+		pstats[ii].nummut += (mut=tmppop->individual(i+1).mutate(pMutation()));
+		if(mut > 0) c2 = 1;
+		pstats[ii].numeval += c1 + c2;
+	}
+	if(nrepl[ii] % 2 != 0){
+		mom = &(deme[ii]->select());
+		dad = &(deme[ii]->select());
+		pstats[ii].numsel += 2;
+		c1 = 0;
+		if(GAFlipCoin(pc)){
+			pstats[ii].numcro +=
+				(*scross)(*mom, *dad, &tmppop->individual(i), (GAGenome*)0);
+			c1 = 1;
+		}
+		else{
+			if(GARandomBit()) tmppop->individual(i).copy(*mom);
+			else              tmppop->individual(i).copy(*dad);
+		}
+		pstats[ii].nummut += (mut=tmppop->individual(i).mutate(pMutation()));
+		if(mut > 0) c1 = 1;
+		pstats[ii].numeval += c1;
+	}
+
+	for(i=0; i<nrepl[ii]; i++)
+		deme[ii]->add(&tmppop->individual(i));
+	deme[ii]->evaluate();
+	deme[ii]->scale();
+	for(i=0; i<nrepl[ii]; i++)
+		tmppop->replace(deme[ii]->remove(GAPopulation::WORST,
+										 GAPopulation::SCALED), i);
+
+	pstats[ii].numrep += nrepl[ii];
+}
+
+// Cópias dos nmig melhores para os vizinhos do anel, feitas sobre os
+// genomas que o vizinho devolveu (ou os livres da ilha); só clona quando não
+// há nenhum. Fila cheia (vizinho atrasado): os migrantes que sobram são
+// descartados, a ilha não espera.
+void GAThreadedDemeGA::emigrate(unsigned int ii){
+
+	unsigned int s = ringstep % npop, j, k, d;
+	unsigned int iWays = (topo==BIDIRECTIONAL_RING) ? 2 : 1;
+	GAGenome *g;
+
+	if(s==0) return;
+
+	for(k=0;k<iWays;k++){
+		d = (k==0) ? (ii+s) % npop : (ii+npop-s) % npop;
+
+		for(j=0;j<nmig && j<(unsigned int) deme[ii]->size();j++){
+			g = recycle[2*d+k]->pop();
+			if(!g && !spare[ii].empty()){
+				g = spare[ii].back();
+				spare[ii].pop_back();
+			}
+
+			if(g) g->copy(deme[ii]->best(j));
+			else  g = deme[ii]->best(j).clone();
+
+			if(!inbox[2*d+k]->push(g)){
+				spare[ii].push_back(g);
+				break;
+			}
+		}
+	}
+}
+
+// Migrantes recebidos (já avaliados) entram no lugar dos piores da ilha; os
+// substituídos voltam para quem mandou, para a próxima migração dele
+void GAThreadedDemeGA::immigrate(unsigned int ii){
+
+	unsigned int k;
+	GAGenome *g, *old;
+
+	for(k=0;k<2;k++)
+		while((g = inbox[2*ii+k]->pop())!=0){
+			old = deme[ii]->replace(g, GAPopulation::WORST);
+			if(old && !recycle[2*ii+k]->push(old))
+				spare[ii].push_back(old);
+		}
+}
+
+// Resumo da ilha para step(): melhor indivíduo e contadores
+void GAThreadedDemeGA::publish(unsigned int ii, int gen){
+
+	{
+		std::lock_guard<std::mutex> lock(slots[ii]->mtx);
+
+		slots[ii]->best->copy(deme[ii]->best());
+		slots[ii]->generation = gen;
+		slots[ii]->numsel = pstats[ii].numsel;
+		slots[ii]->numcro = pstats[ii].numcro;
+		slots[ii]->nummut = pstats[ii].nummut;
+		slots[ii]->numrep = pstats[ii].numrep;
+		slots[ii]->numeval = pstats[ii].numeval;
+		slots[ii]->numpeval = pstats[ii].numpeval;
+	}
+
+	std::lock_guard<std::mutex> lock(mtxDone);
+	cvDone.notify_all();
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+* 	Scheduling_deme.h														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+******************************************************************************/
+
+#ifndef _DEME_
+
+#define _DEME_
+
+#include <ga/GADemeGA.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+* 	Class: MigrantQueue														  *
+*	Short Description: Lock-free single-producer/single-consumer ring of	  *
+*					   genomes between two demes. push() gives up (returns	  *
+*					   false) when the ring is full, pop() returns NULL when  *
+*					   it is empty; neither ever blocks.					  *
+*******************************************************************************/
+
+class MigrantQueue {
+public:
+	explicit MigrantQueue(unsigned int iCapacity);
+	~MigrantQueue();
+
+	bool push(GAGenome *g);
+	GAGenome * pop();
+
+private:
+	MigrantQueue(const MigrantQueue &);
+	MigrantQueue & operator=(const MigrantQueue &);
+
+	std::vector<GAGenome *> ring;
+	unsigned int mask;
+	std::atomic<unsigned int> head;	// próxima posição a ler (consumidor)
+	std::atomic<unsigned int> tail;	// próxima posição a escrever (produtor)
+};
+
+/******************************************************************************
+* 	Class: GAThreadedDemeGA													  *
+*	Short Description: GADemeGA with one thread per deme. Each deme evolves	  *
+*					   as in GADemeGA::step() but at its own pace; every	  *
+*					   migrationInterval() generations it sends copies of its *
+*					   nMigration() best genomes to its neighbours on the	  *
+*					   ring (deme i -> i+ringStep(), and also i-ringStep()	  *
+*					   with BIDIRECTIONAL_RING) through MigrantQueues, and	  *
+*					   the migrants it receives replace its worst genomes.	  *
+*					   ringStep() = 1 is the stepping-stone model of		  *
+*					   GADemeGA::migrate().									  *
+*																			  *
+*					   The genomes a deme replaces go back to the sender	  *
+*					   through a second queue and carry its next migrants,	  *
+*					   so after the first migrations no genome is created	  *
+*					   or deleted during the run.							  *
+*																			  *
+*					   step() starts the demes (first call) and returns when  *
+*					   every deme has finished one more generation, with the  *
+*					   global statistics updated from the published bests of  *
+*					   the demes; the demes are never stopped for that. When  *
+*					   the terminator says done the demes are stopped. With	  *
+*					   TerminateUponGeneration no deme goes past			  *
+*					   nGenerations().										  *
+*																			  *
+*					   Each deme thread seeds its own GAlib generator (see	  *
+*					   GALIB_THREAD_LOCAL) with its own stream of a seed	  *
+*					   drawn from the main one (GARandomSeedStream), and the  *
+*					   thread hooks run on it when it starts and before it	  *
+*					   ends, so the objective function can set up per-thread  *
+*					   state.												  *
+*																			  *
+*					   Runs are not reproducible: each deme's random		  *
+*					   sequence is, but when a migrant arrives depends on	  *
+*					   thread timing, and migrants that find a full queue	  *
+*					   are dropped.											  *
+*******************************************************************************/
+
+class GAThreadedDemeGA : public GADemeGA {
+public:
+	GADefineIdentity("GAThreadedDemeGA", GAID::DemeGA);
+
+	enum Topology {RING, BIDIRECTIONAL_RING};
+	typedef void (*ThreadHook)(int iDeme, void *pData);
+
+public:
+	GAThreadedDemeGA(const GAGenome &);
+	virtual ~GAThreadedDemeGA();
+
+	virtual void initialize(unsigned int seed=0);
+	virtual void step();
+	GAThreadedDemeGA & operator++() { step(); return *this; }
+	void stop();
+
+	int migrationInterval() const {return interval;}
+	int migrationInterval(unsigned int n) {return interval = (n < 1 ? 1 : n);}
+	Topology topology() const {return topo;}
+	Topology topology(Topology t) {return topo = t;}
+	int ringStep() const {return ringstep;}
+	int ringStep(unsigned int n) {return ringstep = (n < 1 ? 1 : n);}
+	void threadHooks(ThreadHook start, ThreadHook end, void *pData)
+		{ hookstart = start; hookend = end; hookdata = pData; }
+
+protected:
+	void run(unsigned int ii, unsigned int seed);
+	void evolveDeme(unsigned int ii);
+	void emigrate(unsigned int ii);
+	void immigrate(unsigned int ii);
+	void publish(unsigned int ii, int gen);
+	void release();
+	void freeMigrants();
+
+	// Resumo de uma ilha publicado pela thread dela a cada geração
+	struct DemeSlot {
+		std::mutex mtx;
+		GAGenome *best;
+		int generation;
+		unsigned long numsel, numcro, nummut, numrep, numeval, numpeval;
+		bool running;
+	};
+
+	unsigned int interval;	// gerações entre duas migrações
+	Topology topo;
+	unsigned int ringstep;	// distância do vizinho no anel
+	ThreadHook hookstart, hookend;
+	void *hookdata;
+
+	std::vector<std::thread> threads;
+	std::vector<GAPopulation *> tmpdeme;		// população temporária de cada ilha
+	std::vector<DemeSlot *> slots;
+	std::vector<MigrantQueue *> inbox;		// inbox[2*ii]: de ii-ringstep, inbox[2*ii+1]: de ii+ringstep
+	std::vector<MigrantQueue *> recycle;	// recycle[2*ii+k]: genomas substituídos em ii, de volta a quem mandou por inbox[2*ii+k]
+	std::vector< std::vector<GAGenome *> > spare;	// genomas livres de cada ilha (só a thread dela mexe)
+	std::atomic<bool> stopping;
+	std::mutex mtxDone;
+	std::condition_variable cvDone;	// uma ilha publicou ou terminou
+	int aggregated;					// gerações já agregadas em stats
+
+private:
+	GAThreadedDemeGA(const GAThreadedDemeGA &);
+	GAThreadedDemeGA & operator=(const GAThreadedDemeGA &);
+};
+
+#endif /* _DEME_ */
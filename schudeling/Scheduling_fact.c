@@ -6,235 +6,974 @@ Revisões
 Data        Observações
 17/06/13    Primeira versão
 18/08/13    Adaptado para problemas não quadráticos - Flávio Grassi
+17/10/26    Simulação orientada a eventos (salta direto para o próximo
+            término de operação em vez de avançar uma unidade por vez)
+17/10/26    Estado da avaliação em EvalContext (reentrante); factivel()
+            passa a ser apenas um invólucro de evaluate()
+17/10/26    decodeSeed(): decodificação direta da semente por ordenação
+            topológica, sem a matriz de prioridades
+17/10/26    Dimensões da instância em tempo de execução (Instance); o
+            rascunho do contexto é alocado por evalInit()
+17/10/26    decodeSeedCutoff(): interrompe a decodificação quando o início
+            da operação mais o trabalho restante do job ou da máquina já
+            alcança o limite
+17/10/26    seedFeasible(): teste de ciclo no grafo disjuntivo em O(J*M),
+            sem calcular tempos
+17/10/26    decodeHeadsTails()/swapEstimate(): cabeças e caudas da semente e
+            estimativa de Taillard para a troca de operações adjacentes
+17/10/26    evaluateBatch(): avalia um lote de sementes em uma chamada
+17/10/26    registerBatchKernel(): avaliação do lote em paralelo por pistas
+            (SIMD); seedOrder() fornece a ordem topológica usada por ela
+17/10/26    cacheInit(): cache de makespans por hash de Zobrist da semente,
+            consultado por decodeSeed(), decodeSeedCutoff() e evaluateBatch()
+17/10/26    analyzeSeed(): grafo disjuntivo em CSR montado uma vez por
+            semente; makespan, cabeças, caudas e caminho crítico em uma só
+            passada. decodeHeadsTails() passa a usá-la
+17/10/26    seedPositions()/seedSwap(): índice de posições da semente
+17/10/26    insertEstimate(): estimativa por cabeças e caudas da inserção de
+            uma operação em outra posição da máquina
+17/10/26    factivel() mantém o contexto entre chamadas; evalInit() informa
+            falha de alocação
 *****************************************************************************/
 
 /* includes */
 #include "Scheduling_fact.h"
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define _DEBUG_FACT_
-
-/* global variables */
-int priority[MACHINE][JOB];
-int tempo[JOB][MACHINE];
-int sequence[SEQUENCE][MACHINE];
-
-int machines[MACHINE];
-int priomachines[MACHINE];
-
-enum{
-	START=0,
-	END,
-};
+#define MAXKERNELS		16
+#define CACHERUN		64		/* candidatas do lote decodificadas por vez */
 
 enum{
 	NOPRIORITY=0,
 	MACHPRIORITY,
 };
 
-struct sequence {
-	int iStep;
-	int iWaiting;
-	int iWaitingFor;
-	int itempo;
-	int iMach;
-	int isActive;
-	int isDead;
-	int iSequences;
-};
-
-struct sequence sSequence[SEQUENCE];
+/* global variables */
+static const Instance *pSelected = NULL;
+static Instance instFactivel;			/* instância do contexto de factivel() */
+static EvalContext ctxFactivel;			/* vazio até a primeira chamada */
+
+static struct kernel {
+	int iMachines;
+	int iJobs;
+	DecodeKernel pf;
+} vKernels[MAXKERNELS];
+static int iKernels = 0;
+static BatchKernel pfBatch = NULL;
 
 /* functions */
 
-void carregadados();
-void checkmachines(int tempostep, int iter, int iPrioMode);
-void checkprocesses(int tempostep, int iter, int iPrioMode);
+static void startmachines(EvalContext *ctx, int iTime);
+static int nextevent(EvalContext *ctx);
+static void finishprocesses(EvalContext *ctx, int iTime);
+static int buildedges(EvalContext *ctx, const int *vSeed);
+static int decodeone(EvalContext *ctx, const int *vSeed, int *vStart,
+					 int iCutoff);
+static int batchdecode(EvalContext *ctx, const int *vSeeds, int iStride,
+					   int iCount, int iCutoff, int *vMakespans);
+static unsigned long long hashseed(const EvalContext *ctx, const int *vSeeds,
+								   int iStride);
+static int cachefind(EvalContext *ctx, unsigned long long key, int iCutoff,
+					 int *piValue);
+static void cachestore(EvalContext *ctx, unsigned long long key, int iValue,
+					   int iCutoff);
 
 int factivel(int *vPriorities, int *vSequences, int iPrioMode, int *iTEMPO){
-//Matriz de tempos nos jobs, NA ORDEM DE MÁQUINAS DE ACORDO COM A MATRIZ DE ROTAS A SER PASSADA NO MAIN
 
-    int JT[JOB][MACHINE];
+	assert(pSelected != NULL);
+
+	// O contexto só é refeito quando as rotas, os tempos ou o modo mudam
+	// (selectInstance() o descarta)
+	if(!ctxFactivel.machines || instFactivel.vRoutes!=vSequences ||
+	   instFactivel.vTimes!=iTEMPO || ctxFactivel.iPrioMode!=iPrioMode){
+		evalFree(&ctxFactivel);
+		instFactivel = *pSelected;
+		instFactivel.vRoutes = vSequences;
+		instFactivel.vTimes = iTEMPO;
+		if(!evalInit(&ctxFactivel, &instFactivel, iPrioMode))
+			return instFactivel.iIter;
+	}
+
+	return evaluate(&ctxFactivel, vPriorities);
+}
+
+void selectInstance(const Instance *pInstance){
+
+	pSelected = pInstance;
+	evalFree(&ctxFactivel);
+}
+
+void registerKernel(int iMachines, int iJobs, DecodeKernel pf){
+
+	int i;
+
+	for(i=0;i<iKernels;i++){
+		if(vKernels[i].iMachines==iMachines && vKernels[i].iJobs==iJobs){
+			vKernels[i].pf = pf;
+			return;
+		}
+	}
+
+	if(iKernels<MAXKERNELS){
+		vKernels[iKernels].iMachines = iMachines;
+		vKernels[iKernels].iJobs = iJobs;
+		vKernels[iKernels].pf = pf;
+		iKernels++;
+	}
+}
+
+void registerBatchKernel(BatchKernel pf){
+
+	pfBatch = pf;
+}
+
+int evalInit(EvalContext *ctx, const Instance *pInstance, int iPrioMode){
+
+	int i, j;
+	int M = pInstance->iMachines, J = pInstance->iJobs;
+	int *block;
+
+	ctx->pInstance = pInstance;
+	ctx->vSequences = pInstance->vRoutes;
+	ctx->vTimes = pInstance->vTimes;
+	ctx->iMachines = M;
+	ctx->iJobs = J;
+	ctx->iIter = pInstance->iIter;
+	ctx->iPrioMode = iPrioMode;
+
+	ctx->pfDecode = NULL;
+	ctx->zobrist = NULL;
+	ctx->cache = NULL;
+	ctx->iCacheMask = 0;
+	ctx->iCacheHits = 0;
+	ctx->iCacheMisses = 0;
+	for(i=0;i<iKernels;i++)
+		if(vKernels[i].iMachines==M && vKernels[i].iJobs==J)
+			ctx->pfDecode = vKernels[i].pf;
+
+	// Um único bloco para todo o rascunho do contexto
+	block = (int *) malloc(sizeof(int)*(2*M + 10*M*J + 2*(M*J+1)*MAXLANES
+										+ 5*(M*J+2) + 2 + 2*GRAPHEDGES(M, J))
+						   + sizeof(struct sequence)*J);
+	ctx->machines = block;
+	if(!block) return 0;
+
+	ctx->priomachines = ctx->machines + M;
+	ctx->ordmachines = ctx->priomachines + M;
+	ctx->opmachine = ctx->ordmachines + M*J;
+	ctx->indegree = ctx->opmachine + M*J;
+	ctx->mnext = ctx->indegree + M*J;
+	ctx->ready = ctx->mnext + M*J;
+	ctx->start = ctx->ready + M*J;
+	ctx->tail = ctx->start + M*J;
+	ctx->mtail = ctx->tail + M*J;
+	ctx->order = ctx->mtail + M*J;
+	ctx->seed = ctx->order + M*J;
+	ctx->lanes = ctx->seed + M*J;
+	ctx->succptr = ctx->lanes + 2*(M*J+1)*MAXLANES;
+	ctx->succ = ctx->succptr + M*J+3;
+	ctx->predptr = ctx->succ + GRAPHEDGES(M, J);
+	ctx->pred = ctx->predptr + M*J+3;
+	ctx->dist = ctx->pred + GRAPHEDGES(M, J);
+	ctx->degree = ctx->dist + M*J+2;
+	ctx->queue = ctx->degree + M*J+2;
+	ctx->sSequence = (struct sequence *) (ctx->queue + M*J+2);
+
+	for(i=0;i<J;i++)
+		for(j=0;j<M;j++)
+			ctx->opmachine[i*M+j] = -1;
+
+	for(i=0;i<J;i++)
+		for(j=0;j<M;j++)
+			if(ctx->vSequences[i*M+j]>=1 && ctx->vSequences[i*M+j]<=M)
+				ctx->opmachine[i*M+ctx->vSequences[i*M+j]-1] = j;
+
+	// Trabalho restante do job a partir de cada operação (inclusive)
+	for(i=0;i<J;i++){
+		ctx->tail[i*M+M-1] = ctx->vTimes[i*M+M-1];
+		for(j=M-2;j>=0;j--)
+			ctx->tail[i*M+j] = ctx->vTimes[i*M+j] + ctx->tail[i*M+j+1];
+	}
+
+	return 1;
+}
+
+void evalFree(EvalContext *ctx){
+
+	free(ctx->machines);
+	ctx->machines = NULL;
+
+	free(ctx->zobrist);
+	ctx->zobrist = NULL;
+	ctx->cache = NULL;
+}
+
+void cacheInit(EvalContext *ctx, int iEntries){
+
+	int i;
+	int iKeys = ctx->iMachines*ctx->iJobs*ctx->iJobs;
+	unsigned long iSize = 1;
+	unsigned long long x = 0x5EEDULL, z;
+
+	free(ctx->zobrist);
+
+	if(iEntries<=0) iEntries = CACHEPEROP*ctx->iMachines*ctx->iJobs;
+	while(iSize<(unsigned long) iEntries) iSize <<= 1;
+
+	// Chaves de Zobrist e tabela no mesmo bloco; a tabela começa vazia
+	ctx->zobrist = (unsigned long long *) calloc(iKeys + 2*iSize, sizeof(unsigned long long));
+	ctx->iCacheHits = 0;
+	ctx->iCacheMisses = 0;
+	if(!ctx->zobrist){
+		// Sem memória o contexto segue sem cache
+		ctx->cache = NULL;
+		ctx->iCacheMask = 0;
+		return;
+	}
+	ctx->cache = ctx->zobrist + iKeys;
+	ctx->iCacheMask = iSize - 1;
+
+	// splitmix64 com semente fixa: as chaves não dependem de rand() e não
+	// alteram a sequência aleatória do AG
+	for(i=0;i<iKeys;i++){
+		x += 0x9E3779B97F4A7C15ULL;
+		z = x;
+		z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+		ctx->zobrist[i] = z ^ (z>>31);
+	}
+}
+
+void cacheClear(EvalContext *ctx){
+
+	if(ctx->cache)
+		memset(ctx->cache, 0, sizeof(unsigned long long)*2*(ctx->iCacheMask+1));
+
+	ctx->iCacheHits = 0;
+	ctx->iCacheMisses = 0;
+}
+
+unsigned long long seedHash(const EvalContext *ctx, const int *vSeed){
+
+	return hashseed(ctx, vSeed, 1);
+}
+
+int decodeSeed(EvalContext *ctx, const int *vSeed, int *vStart){
+
+	// Com vStart o chamador quer os inícios, que o cache não guarda
+	if(vStart) return decodeone(ctx, vSeed, vStart, ctx->iIter);
+
+	return decodeSeedCutoff(ctx, vSeed, ctx->iIter);
+}
+
+int decodeSeedCutoff(EvalContext *ctx, const int *vSeed, int iCutoff){
+
+	unsigned long long key;
+	int iRet;
+
+	if(iCutoff>ctx->iIter) iCutoff = ctx->iIter;
+
+	if(!ctx->cache) return decodeone(ctx, vSeed, NULL, iCutoff);
+
+	key = hashseed(ctx, vSeed, 1);
+	if(cachefind(ctx, key, iCutoff, &iRet)) return iRet;
+
+	iRet = decodeone(ctx, vSeed, NULL, iCutoff);
+	cachestore(ctx, key, iRet, iCutoff);
+
+	return iRet;
+}
+
+int evaluateBatch(EvalContext *ctx, const int *vSeeds, int iStride, int iCount,
+				  int iCutoff, int *vMakespans){
+
+	unsigned long long vKeys[CACHERUN];
+	int c, n, i, iHit, iBetter = 0;
+
+	if(iCutoff>ctx->iIter) iCutoff = ctx->iIter;
+
+	if(!ctx->cache) return batchdecode(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+
+	// As candidatas que já estão no cache são respondidas direto. As demais
+	// são decodificadas em trechos contíguos, que continuam sendo um lote
+	// válido: começam na coluna c e mantêm o passo iStride.
+	for(c=0;c<iCount;){
+		iHit = 0;
+		for(n=0;n<CACHERUN && c+n<iCount;n++){
+			vKeys[n] = hashseed(ctx, vSeeds+c+n, iStride);
+			if(cachefind(ctx, vKeys[n], iCutoff, &vMakespans[c+n])){
+				iHit = 1;
+				break;
+			}
+		}
+
+		if(n>0){
+			batchdecode(ctx, vSeeds+c, iStride, n, iCutoff, vMakespans+c);
+			for(i=0;i<n;i++)
+				cachestore(ctx, vKeys[i], vMakespans[c+i], iCutoff);
+		}
+
+		c += n + iHit;
+	}
+
+	for(c=0;c<iCount;c++)
+		if(vMakespans[c]<iCutoff) iBetter++;
+
+	return iBetter;
+}
+
+int evaluateBatchScalar(EvalContext *ctx, const int *vSeeds, int iStride,
+						int iCount, int iCutoff, int *vMakespans){
+
+	int c, i, iBetter = 0;
+	int iSize = ctx->iMachines*ctx->iJobs;
+	int *seed = ctx->seed;
+
+	if(iCutoff>ctx->iIter) iCutoff = ctx->iIter;
+
+	// O rascunho do contexto é o mesmo para todas as candidatas; cada uma
+	// é copiada da sua coluna do lote e decodificada em seguida
+	for(c=0;c<iCount;c++){
+		for(i=0;i<iSize;i++)
+			seed[i] = vSeeds[i*iStride+c];
+
+		if(ctx->pfDecode) vMakespans[c] = ctx->pfDecode(ctx, seed, NULL, iCutoff);
+		else vMakespans[c] = decodeSeedGeneric(ctx, seed, NULL, iCutoff);
+
+		if(vMakespans[c]<iCutoff) iBetter++;
+	}
+
+	return iBetter;
+}
+
+int decodeSeedGeneric(EvalContext *ctx, const int *vSeed, int *vStart,
+					  int iCutoff){
+
+	int i, m, k, op, next, job, fin, rest;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int iTop = 0, iDone = 0, iMakespan = 0;
+	int *start = vStart ? vStart : ctx->start;
+	int *indegree = ctx->indegree;
+	int *mnext = ctx->mnext;
+	int *ready = ctx->ready;
+	int *tail = ctx->tail;
+	int *mtail = ctx->mtail;
+	const int *vTimes = ctx->vTimes;
+
+	if(!buildedges(ctx, vSeed)) return ctx->iIter;
+
+	for(op=0;op<J*M;op++)
+		start[op] = 0;
+
+	// Trabalho restante da máquina a partir de cada operação (inclusive)
+	for(m=0;m<M;m++){
+		rest = 0;
+		for(k=J-1;k>=0;k--){
+			job = vSeed[m*J+k]-1;
+			op = job*M + ctx->opmachine[job*M+m];
+			rest += vTimes[op];
+			mtail[op] = rest;
+		}
+	}
+
+	for(op=0;op<J*M;op++)
+		if(indegree[op]==0) ready[iTop++] = op;
+
+	// Ordem topológica: cada operação começa quando o job e a máquina liberam
+	while(iTop>0){
+		op = ready[--iTop];
+		iDone++;
+
+		// O início já é definitivo: nenhum término pode ficar abaixo disto
+		if(start[op]+tail[op]>=iCutoff || start[op]+mtail[op]>=iCutoff)
+			return iCutoff;
+
+		fin = start[op] + vTimes[op];
+		if(fin>iMakespan) iMakespan = fin;
+
+		for(i=0;i<2;i++){
+			if(i==0) next = ((op+1)%M) ? op+1 : -1;
+			else next = mnext[op];
+			if(next<0) continue;
+
+			if(fin>start[next]) start[next] = fin;
+			if(--indegree[next]==0) ready[iTop++] = next;
+		}
+	}
+
+	if(iDone<J*M) return ctx->iIter;
+	if(iMakespan>=iCutoff) return iCutoff;
+
+	return iMakespan;
+}
+
+void seedPositions(const EvalContext *ctx, const int *vSeed, int *vPos){
+
+	int m, k, job;
+	int M = ctx->iMachines, J = ctx->iJobs;
+
+	for(k=0;k<M*J;k++)
+		vPos[k] = -1;
+
+	for(m=0;m<M;m++){
+		for(k=0;k<J;k++){
+			job = vSeed[m*J+k]-1;
+			if(job>=0 && job<J) vPos[m*J+job] = m*J+k;
+		}
+	}
+}
+
+void seedSwap(const EvalContext *ctx, int *vSeed, int *vPos, int iA, int iB){
+
+	int J = ctx->iJobs, m = iA/J;
+	int a = vSeed[iA], b = vSeed[iB];
+
+	vSeed[iA] = b;
+	vSeed[iB] = a;
+
+	vPos[m*J+b-1] = iA;
+	vPos[m*J+a-1] = iB;
+}
+
+int seedFeasible(EvalContext *ctx, const int *vSeed){
+
+	return seedOrder(ctx, vSeed, ctx->order)==ctx->iMachines*ctx->iJobs;
+}
+
+int seedOrder(EvalContext *ctx, const int *vSeed, int *vOrder){
+
+	int op, next;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int iTop = 0, iDone = 0;
+	int *indegree = ctx->indegree;
+	int *mnext = ctx->mnext;
+	int *ready = ctx->ready;
 
-    int intElemento = 0;
-    int iJob, iMachine;
+	if(!buildedges(ctx, vSeed)) return 0;
 
-    // ALIMENTA MATRIZ JT COM OS TEMPOS DO VETOR T
-    for(iJob=0; iJob < JOB; iJob++) {
-        for(iMachine=0; iMachine < MACHINE; iMachine++) {
-            JT[iJob][iMachine]=iTEMPO[intElemento++];
+	for(op=0;op<J*M;op++)
+		if(indegree[op]==0) ready[iTop++] = op;
 
-        }
-    }
+	// Kahn: as operações de um ciclo nunca chegam a grau de entrada zero
+	while(iTop>0){
+		op = ready[--iTop];
+		vOrder[iDone++] = op;
 
-	int i,j; //,k;
-	int iter; //, mach;
+		if((op+1)%M && --indegree[op+1]==0) ready[iTop++] = op+1;
 
-    for(i=0;i<JOB;i++)
-		for(j=0;j<MACHINE;j++)
-			tempo[i][j] = JT[i][j];
+		next = mnext[op];
+		if(next>=0 && --indegree[next]==0) ready[iTop++] = next;
+	}
+
+	return iDone;
+}
+
+int decodeHeadsTails(EvalContext *ctx, const int *vSeed, int *vHead, int *vTail){
+
+	return analyzeSeed(ctx, vSeed, vHead, vTail, NULL, NULL);
+}
+
+int analyzeSeed(EvalContext *ctx, const int *vSeed, int *vHead, int *vTail,
+				int *vPath, int *piPath){
+
+	int i, e, x, u, q, dur, best;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int N = M*J+1, V = M*J+2;			// nó 0 = início, op+1, N = fim
+	int iHead = 0, iDone = 0, iLen = 0;
+	int *succptr = ctx->succptr, *succ = ctx->succ;
+	int *predptr = ctx->predptr, *pred = ctx->pred;
+	int *dist = ctx->dist, *degree = ctx->degree, *queue = ctx->queue;
+	int *mnext = ctx->mnext;
+	const int *vTimes = ctx->vTimes;
+
+	if(piPath) *piPath = 0;
+	if(!buildedges(ctx, vSeed)) return ctx->iIter;
+
+	// Graus: o início liga à primeira operação de cada job; cada operação
+	// liga à seguinte do job (ou ao fim) e à seguinte da máquina, se houver
+	succptr[0] = 0;
+	succptr[1] = J;
+	predptr[0] = 0;
+	predptr[1] = 0;
+	for(x=1;x<N;x++){
+		succptr[x+1] = succptr[x] + 1 + (mnext[x-1]>=0);
+		predptr[x+1] = predptr[x] + ctx->indegree[x-1] + ((x-1)%M==0);
+	}
+	succptr[N+1] = succptr[N];
+	predptr[N+1] = predptr[N] + J;
+
+	// Sucessores; os antecessores ficam na ordem das arestas do método CPM
+	// original (job antes de máquina, jobs em ordem no fim), que decide os
+	// empates do caminho crítico
+	for(x=0;x<V;x++)
+		degree[x] = predptr[x];
+
+	for(i=0;i<J;i++){
+		succ[i] = i*M+1;
+		pred[degree[i*M+1]++] = 0;
+	}
+	for(x=1;x<N;x++){
+		u = (x%M) ? x+1 : N;
+		succ[succptr[x]] = u;
+		pred[degree[u]++] = x;
+	}
+	for(x=1;x<N;x++){
+		if(mnext[x-1]<0) continue;
+		u = mnext[x-1]+1;
+		succ[succptr[x]+1] = u;
+		pred[degree[u]++] = x;
+	}
+
+	// Cabeças: Kahn sobre o CSR, cada aresta visitada uma vez
+	for(x=0;x<V;x++){
+		dist[x] = 0;
+		degree[x] = predptr[x+1] - predptr[x];
+	}
+	queue[iDone++] = 0;
+
+	while(iHead<iDone){
+		x = queue[iHead++];
+		dur = (x>0 && x<N) ? vTimes[x-1] : 0;
+
+		for(e=succptr[x];e<succptr[x+1];e++){
+			u = succ[e];
+			if(dist[x]+dur>dist[u]) dist[u] = dist[x]+dur;
+			if(--degree[u]==0) queue[iDone++] = u;
+		}
+	}
 
-    for(i=0;i<MACHINE;i++)
-		for(j=0;j<JOB;j++)
-			priority[i][j] = vPriorities[i*JOB+j];
+	if(vHead)
+		for(x=1;x<N;x++)
+			vHead[x-1] = dist[x];
 
-    for(i=0;i<SEQUENCE;i++)
-		for(j=0;j<MACHINE;j++)
-			sequence[i][j]=vSequences[i*MACHINE+j];
+	// Caudas na ordem inversa: maior caminho do término da operação até o fim
+	if(vTail && iDone==V){
+		for(i=V-1;i>=0;i--){
+			x = queue[i];
+			if(x==0 || x==N) continue;
+
+			q = 0;
+			for(e=succptr[x];e<succptr[x+1];e++){
+				u = succ[e];
+				if(u!=N && vTail[u-1]+vTimes[u-1]>q) q = vTail[u-1]+vTimes[u-1];
+			}
+			vTail[x-1] = q;
+		}
+	}
 
+	// Caminho crítico, do fim para o início: o nó de maior distância e, a
+	// cada passo, o antecessor de maior cabeça (o último, se todas são zero).
+	// Com ciclo, parte das distâncias parciais, como o CPM original.
+	if(vPath){
+		u = 0;
+		for(x=1;x<V;x++)
+			if(dist[x]>dist[u]) u = x;
+
+		while(u!=0 && iLen<V){
+			best = predptr[u];
+			for(e=predptr[u]+1;e<predptr[u+1];e++)
+				if(dist[pred[e]]>dist[pred[best]]) best = e;
+			if(dist[pred[best]]==0) best = predptr[u+1]-1;
+
+			u = pred[best];
+			vPath[iLen++] = u;
+		}
+		*piPath = iLen;
+	}
+
+	if(iDone<V || dist[N]>=ctx->iIter) return ctx->iIter;
+
+	return dist[N];
+}
+
+int swapEstimate(EvalContext *ctx, const int *vSeed, const int *vHead,
+				 const int *vTail, int iMachine, int iPos){
+
+	int M = ctx->iMachines, J = ctx->iJobs;
+	const int *vTimes = ctx->vTimes;
+	const int *vOrder = vSeed + iMachine*J;
+	int u, v, a, b, ru, rv, qu, qv, x;
+
+	// u e v: operações nas posições iPos e iPos+1 da máquina
+	u = (vOrder[iPos]-1)*M + ctx->opmachine[(vOrder[iPos]-1)*M+iMachine];
+	v = (vOrder[iPos+1]-1)*M + ctx->opmachine[(vOrder[iPos+1]-1)*M+iMachine];
+
+	// Nova cabeça de v, agora à frente de u na máquina
+	rv = (v%M) ? vHead[v-1]+vTimes[v-1] : 0;
+	if(iPos>0){
+		a = (vOrder[iPos-1]-1)*M + ctx->opmachine[(vOrder[iPos-1]-1)*M+iMachine];
+		if(vHead[a]+vTimes[a]>rv) rv = vHead[a]+vTimes[a];
+	}
+
+	ru = (u%M) ? vHead[u-1]+vTimes[u-1] : 0;
+	if(rv+vTimes[v]>ru) ru = rv+vTimes[v];
+
+	// Nova cauda de u, agora atrás de v na máquina
+	qu = ((u+1)%M) ? vTail[u+1]+vTimes[u+1] : 0;
+	if(iPos+2<J){
+		b = (vOrder[iPos+2]-1)*M + ctx->opmachine[(vOrder[iPos+2]-1)*M+iMachine];
+		if(vTail[b]+vTimes[b]>qu) qu = vTail[b]+vTimes[b];
+	}
+
+	qv = ((v+1)%M) ? vTail[v+1]+vTimes[v+1] : 0;
+	if(qu+vTimes[u]>qv) qv = qu+vTimes[u];
+
+	x = rv + vTimes[v] + qv;
+	if(ru + vTimes[u] + qu > x) x = ru + vTimes[u] + qu;
+
+	return x;
+}
+
+int insertEstimate(EvalContext *ctx, const int *vSeed, const int *vHead,
+				   const int *vTail, int iMachine, int iFrom, int iTo){
+
+	int M = ctx->iMachines, J = ctx->iJobs;
+	const int *vTimes = ctx->vTimes;
+	const int *vOrder = vSeed + iMachine*J;
+	int *seg = ctx->order;				// rascunho: operações do trecho na nova ordem
+	int i, n, u, w, a, r, q, x;
+
+#define OPPOS(p) ((vOrder[p]-1)*M + ctx->opmachine[(vOrder[p]-1)*M+iMachine])
+
+	if(iFrom==iTo) return ctx->iIter;
+
+	// Teste de ciclo e trecho na nova ordem: a operação movida u fica depois
+	// (ou antes) das que estão até iTo
+	u = OPPOS(iFrom);
+	w = OPPOS(iTo);
+	n = 0;
+	if(iFrom<iTo){
+		if(((u+1)%M) && vHead[w]>=vHead[u+1]+vTimes[u+1]) return ctx->iIter;
+		for(i=iFrom+1;i<=iTo;i++) seg[n++] = OPPOS(i);
+		seg[n++] = u;
+	}
+	else{
+		if((u%M) && vTail[w]>=vTail[u-1]+vTimes[u-1]) return ctx->iIter;
+		seg[n++] = u;
+		for(i=iTo;i<iFrom;i++) seg[n++] = OPPOS(i);
+	}
+
+	// Novas cabeças, da primeira posição do trecho para a última; ficam em
+	// seg[J..] (n <= J)
+	a = (iFrom<iTo ? iFrom : iTo) - 1;
+	r = (a>=0) ? vHead[OPPOS(a)]+vTimes[OPPOS(a)] : 0;
+	for(i=0;i<n;i++){
+		x = seg[i];
+		if((x%M) && vHead[x-1]+vTimes[x-1]>r) r = vHead[x-1]+vTimes[x-1];
+		seg[J+i] = r;
+		r += vTimes[x];
+	}
+
+	// Novas caudas, da última para a primeira, e o maior caminho pelo trecho
+	a = (iFrom<iTo ? iTo : iFrom) + 1;
+	q = (a<J) ? vTail[OPPOS(a)]+vTimes[OPPOS(a)] : 0;
+	r = 0;
+	for(i=n-1;i>=0;i--){
+		x = seg[i];
+		if(((x+1)%M) && vTail[x+1]+vTimes[x+1]>q) q = vTail[x+1]+vTimes[x+1];
+		if(seg[J+i]+vTimes[x]+q>r) r = seg[J+i]+vTimes[x]+q;
+		q += vTimes[x];
+	}
+
+#undef OPPOS
+
+	return r;
+}
+
+static int decodeone(EvalContext *ctx, const int *vSeed, int *vStart,
+					 int iCutoff){
+
+	if(ctx->pfDecode) return ctx->pfDecode(ctx, vSeed, vStart, iCutoff);
+
+	return decodeSeedGeneric(ctx, vSeed, vStart, iCutoff);
+}
+
+static int batchdecode(EvalContext *ctx, const int *vSeeds, int iStride,
+					   int iCount, int iCutoff, int *vMakespans){
+
+	if(pfBatch) return pfBatch(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+
+	return evaluateBatchScalar(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+}
+
+// Hash de Zobrist: xor das chaves (posição, job) de toda a semente
+static unsigned long long hashseed(const EvalContext *ctx, const int *vSeeds,
+								   int iStride){
+
+	int i, job;
+	int J = ctx->iJobs, iSize = ctx->iMachines*ctx->iJobs;
+	unsigned long long key = 0;
+
+	for(i=0;i<iSize;i++){
+		job = vSeeds[i*iStride]-1;
+		if(job<0 || job>=J) return 0;
+		key ^= ctx->zobrist[i*J+job];
+	}
+
+	return key;
+}
+
+// Entrada: data = makespan<<1 | exato. Um limite inferior só responde se
+// já alcança o corte pedido.
+static int cachefind(EvalContext *ctx, unsigned long long key, int iCutoff,
+					 int *piValue){
+
+	unsigned long long *slot, data;
+	int iValue;
+
+	if(!key) return 0;
+
+	slot = ctx->cache + 2*(key & ctx->iCacheMask);
+	data = slot[1];
+
+	if(data && (slot[0]^data)==key){
+		iValue = (int) (data>>1);
+		if((data&1) || iValue>=iCutoff){
+			*piValue = iValue;
+			ctx->iCacheHits++;
+			return 1;
+		}
+	}
+
+	ctx->iCacheMisses++;
+	return 0;
+}
+
+// O resultado é exato abaixo do corte ou quando a semente é infactível
+// (iIter); acima do corte é só um limite inferior
+static void cachestore(EvalContext *ctx, unsigned long long key, int iValue,
+					   int iCutoff){
+
+	unsigned long long *slot, data;
+	int iExact = iValue<iCutoff || iValue>=ctx->iIter;
+
+	if(!key) return;
+
+	slot = ctx->cache + 2*(key & ctx->iCacheMask);
+	data = ((unsigned long long) iValue<<1) | (unsigned long long) iExact;
+	slot[1] = data;
+	slot[0] = key^data;
+}
+
+// Monta em indegree/mnext o grafo disjuntivo da semente. Devolve 0 se a
+// semente não é uma permutação dos jobs em cada máquina.
+static int buildedges(EvalContext *ctx, const int *vSeed){
+
+	int m, k, op, prev, job;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int *indegree = ctx->indegree;
+	int *mnext = ctx->mnext;
+
+	// Arestas de job: toda operação, menos a primeira de cada job, depende
+	// da anterior. mnext == -2 marca operação ainda não vista na semente.
+	for(op=0;op<J*M;op++){
+		indegree[op] = (op%M) ? 1 : 0;
+		mnext[op] = -2;
+	}
+
+	// Arestas de máquina, na ordem dada pela semente
+	for(m=0;m<M;m++){
+		prev = -1;
+		for(k=0;k<J;k++){
+			job = vSeed[m*J+k]-1;
+			if(job<0 || job>=J || ctx->opmachine[job*M+m]<0) return 0;
+
+			op = job*M + ctx->opmachine[job*M+m];
+			if(mnext[op]!=-2) return 0;
+
+			mnext[op] = -1;
+			if(prev>=0){
+				mnext[prev] = op;
+				indegree[op]++;
+			}
+			prev = op;
+		}
+	}
+
+	return 1;
+}
+
+int evaluate(EvalContext *ctx, int *vPriorities){
+
+	int i,j;
+	int iTime, iNext;
+	int M = ctx->iMachines, J = ctx->iJobs;
 
 #ifdef _DEBUG_FACT_
 /*	printf("\n tempos\n");
-	for(i=0;i<JOB;i++){
-		for(j=0;j<MACHINE;j++)
-		printf("%d\t", tempo[i][j]);
+	for(i=0;i<J;i++){
+		for(j=0;j<M;j++)
+		printf("%d\t", ctx->vTimes[i*M+j]);
 		printf("\n");
 	}
 
 	printf("\n\n Priorities\n");
-	for(i=0;i<MACHINE;i++){
-		for(j=0;j<JOB;j++)
-			printf("%d\t", priority[i][j]);
+	for(i=0;i<M;i++){
+		for(j=0;j<J;j++)
+			printf("%d\t", vPriorities[i*J+j]);
 		printf("\n");
 	}
 
 	printf("\n\n Sequences\n");
-	for(i=0;i<SEQUENCE;i++){
-		for(j=0;j<MACHINE;j++)
-			printf("%d\t", sequence[i][j]);
+	for(i=0;i<J;i++){
+		for(j=0;j<M;j++)
+			printf("%d\t", ctx->vSequences[i*M+j]);
 		printf("\n");
 	}*/
 #endif //_DEBUG_FACT_
 
-	for(i=0;i<MACHINE;i++){
-		machines[i]=0;
-		priomachines[i]=1;
+	for(i=0;i<M;i++){
+		ctx->machines[i]=0;
+		ctx->priomachines[i]=1;
 	}
 
-	for(i=0;i<SEQUENCE;i++){
-		sSequence[i].itempo = 0;
-		sSequence[i].iStep = 0;
-		sSequence[i].iWaiting = 1;
-		sSequence[i].iWaitingFor = sequence[i][sSequence[i].iStep]-1;
-		sSequence[i].isActive = 0;
-		sSequence[i].isDead = 0;
-		sSequence[i].iSequences = MACHINE;
+	// ordmachines[i][k]: job com prioridade k+1 na maquina i (-1 se nenhum).
+	// Em caso de prioridade repetida vale o menor job, como na busca linear.
+	if(ctx->iPrioMode==MACHPRIORITY){
+		for(i=0;i<M;i++){
+			for(j=0;j<J;j++)
+				ctx->ordmachines[i*J+j] = -1;
+			for(j=J-1;j>=0;j--)
+				if(vPriorities[i*J+j]>=1 && vPriorities[i*J+j]<=J)
+					ctx->ordmachines[i*J+vPriorities[i*J+j]-1] = j;
+		}
 	}
 
-//    ofstream fileSch;
-//    fileSch.open(ArqSch.c_str(), ios::app);
+	for(i=0;i<J;i++){
+		ctx->sSequence[i].itempo = 0;
+		ctx->sSequence[i].iFinish = 0;
+		ctx->sSequence[i].iStep = 0;
+		ctx->sSequence[i].iWaiting = 1;
+		ctx->sSequence[i].iWaitingFor = ctx->vSequences[i*M]-1;
+		ctx->sSequence[i].isActive = 0;
+		ctx->sSequence[i].isDead = 0;
+		ctx->sSequence[i].iSequences = M;
+	}
 
-	for(iter=0;iter<ITER;iter++){
+	// Cada iteração avança o relógio até o próximo término de operação:
+	// inicia o que for possível nas máquinas livres, encontra o menor
+	// instante de término entre as sequências ativas e encerra todas as
+	// operações que terminam nesse instante. Se nada estiver ativo e ainda
+	// houver sequências vivas, nenhuma máquina pode iniciar (impasse) e o
+	// resultado é o mesmo de simular até ITER.
+	iTime = 0;
+	for(;;){
+		startmachines(ctx, iTime);
+
+		iNext = nextevent(ctx);
+		if(iNext < 0) break;
+		if(iNext > ctx->iIter){
+			iTime = ctx->iIter;
+			break;
+		}
 
-		checkmachines(START, iter, iPrioMode);
-		checkprocesses(START, iter, iPrioMode);
-		checkmachines(END, iter, iPrioMode);
-		checkprocesses(END, iter, iPrioMode);
-      j=0;
-      for(i=0;i<SEQUENCE;i++)
-         if(!sSequence[i].isDead) j=1;
-	   if(!j) break;
+		iTime = iNext;
+		finishprocesses(ctx, iTime);
 	}
 
-  //  fileHst.close();
+	for(i=0;i<J;i++)
+		if(!ctx->sSequence[i].isDead) iTime = ctx->iIter;
 
-	if(iter==ITER) {
+	if(iTime>=ctx->iIter) {
         #ifdef _DEBUG_FACT_
          //   printf("\n *** NAO FACTIVEL ***");
             // getchar();
         #endif //_DEBUG_FACT_
 
-        return iter;
+        return ctx->iIter;
 	} else {
         #ifdef _DEBUG_FACT_
             printf("\n FACTIVEL ");
-			printf("%d\t", iter);
+			printf("%d\t", iTime-1);
         #endif //_DEBUG_FACT_
 
-	    return iter+1;
+	    return iTime;
 	}
 
 }
 
-void checkmachines(int tempostep, int iter, int iPrioMode){
+static void startmachines(EvalContext *ctx, int iTime){
 
 	int i, j;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	struct sequence *sSequence = ctx->sSequence;
 
-	for(i=0;i<MACHINE;i++){
+	for(i=0;i<M;i++){
 
-		if(iPrioMode==NOPRIORITY){
-			if(!machines[i]){
-				for(j=0;j<SEQUENCE;j++){
-					if(!machines[i] && sSequence[j].isActive==0
-						&& sSequence[j].iWaitingFor==i && !sSequence[j].isDead){
-						sSequence[j].itempo = 0;
-						sSequence[j].iMach = i;
-						sSequence[j].isActive = 1;
-#ifdef _DEBUG_FACT_
-                        //Luis
-						//printf("\n Sequence %d started in machine %d at %d", j+1, i+1, iter);
-#endif //_DEBUG_FACT_
-						machines[i]=1;
-					}
-				}
+		if(ctx->machines[i]) continue;
+
+		if(ctx->iPrioMode==NOPRIORITY){
+			for(j=0;j<J;j++){
+				if(sSequence[j].isActive==0
+					&& sSequence[j].iWaitingFor==i && !sSequence[j].isDead) break;
 			}
+			if(j==J) continue;
 		}
+		else if(ctx->iPrioMode==MACHPRIORITY){
+			if(ctx->priomachines[i]>J) continue;
+			j = ctx->ordmachines[i*J+ctx->priomachines[i]-1];
 
-		if(iPrioMode==MACHPRIORITY){
-			if(!machines[i]){
-				for(j=0;j<JOB;j++) if(priority[i][j]==priomachines[i]) break;
+			if(j<0 || sSequence[j].isActive
+				|| sSequence[j].iWaitingFor!=i || sSequence[j].isDead) continue;
 
-				if(!machines[i] && sSequence[j].isActive==0
-					&& sSequence[j].iWaitingFor==i && !sSequence[j].isDead){
+			ctx->priomachines[i]=ctx->priomachines[i]+1;
+		}
+		else continue;
 
-					priomachines[i]=priomachines[i]+1;
-					sSequence[j].itempo = 0;
-					sSequence[j].iMach = i;
-					sSequence[j].isActive = 1;
+		sSequence[j].itempo = iTime;
+		sSequence[j].iFinish = iTime + ctx->vTimes[j*M+sSequence[j].iStep];
+		sSequence[j].iMach = i;
+		sSequence[j].isActive = 1;
 #ifdef _DEBUG_FACT_
-                    //Luis
-					//printf("\n Sequence %d started in machine %d at %d", j+1, i+1, iter);
+		//printf("\n Sequence %d started in machine %d at %d", j+1, i+1, iTime);
 #endif //_DEBUG_FACT_
-					machines[i]=1;
-				}
+		ctx->machines[i]=1;
+	}
+}
 
-			}
-		}
+static int nextevent(EvalContext *ctx){
 
-	}
+	int j, iNext = -1;
+	struct sequence *sSequence = ctx->sSequence;
+
+	for(j=0;j<ctx->iJobs;j++)
+		if(sSequence[j].isActive && (iNext<0 || sSequence[j].iFinish<iNext))
+			iNext = sSequence[j].iFinish;
+
+	return iNext;
 }
 
-void checkprocesses(int tempostep, int iter, int iPrioMode){
+static void finishprocesses(EvalContext *ctx, int iTime){
 
 	int j;
+	int M = ctx->iMachines;
+	struct sequence *sSequence = ctx->sSequence;
 
-	for(j=0;j<SEQUENCE;j++){
-		if(sSequence[j].isActive){
-			if(sSequence[j].itempo>=tempo[j][sSequence[j].iStep]){
-				sSequence[j].isActive=0;
-#ifdef _DEBUG_FACT_
-				//printf("\n Sequence %d finished in machine %d at %d", j+1, sSequence[j].iMach+1, iter+1);
-#endif //_DEBUG_FACT_
-				sSequence[j].iStep++;
-				sSequence[j].iWaiting=1;
-				sSequence[j].iWaitingFor=sequence[j][sSequence[j].iStep]-1;
+	for(j=0;j<ctx->iJobs;j++){
+		if(sSequence[j].isActive && sSequence[j].iFinish<=iTime){
+			sSequence[j].isActive=0;
 #ifdef _DEBUG_FACT_
-            //printf("\n Sequence %d is at step %d waiting for %d", j+1, sSequence[j].iStep, sequence[j][sSequence[j].iStep]);
+			//printf("\n Sequence %d finished in machine %d at %d", j+1, sSequence[j].iMach+1, iTime);
 #endif //_DEBUG_FACT_
-				machines[sSequence[j].iMach]=0;
-				//}
-			}
+			sSequence[j].iStep++;
+			ctx->machines[sSequence[j].iMach]=0;
+
 			if(sSequence[j].iStep>=sSequence[j].iSequences){
 				sSequence[j].isDead=1;
 #ifdef _DEBUG_FACT_
 				//printf("\n Sequence %d is dead", j+1);
 #endif //_DEBUG_FACT_
-				machines[sSequence[j].iMach]=0;
+			} else {
+				sSequence[j].iWaiting=1;
+				sSequence[j].iWaitingFor=ctx->vSequences[j*M+sSequence[j].iStep]-1;
+#ifdef _DEBUG_FACT_
+				//printf("\n Sequence %d is at step %d waiting for %d", j+1, sSequence[j].iStep, ctx->vSequences[j*M+sSequence[j].iStep]);
+#endif //_DEBUG_FACT_
 			}
-			if(tempostep==START)
-				sSequence[j].itempo++;
-
 		}
 	}
 
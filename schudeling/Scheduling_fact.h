@@ -5,6 +5,17 @@
 *	17/Jun/13    First release												  *
 *	18/Aug/13    Modified by Flavio Grassi to support "square" problems 	  *
 *	29/Mar/14    Modified by Flavio Grassi to support random processing times *
+*	17/Oct/26    Reentrant evaluation through EvalContext					  *
+*	17/Oct/26    Runtime instance dimensions (Instance) instead of PROGRAMA_xx*
+*	17/Oct/26    decodeSeedCutoff(): stops once the makespan cannot improve  *
+*	17/Oct/26    seedFeasible(): O(J*M) cycle check of the seed				  *
+*	17/Oct/26    Heads/tails and the adjacent swap estimate (Taillard)		  *
+*	17/Oct/26    evaluateBatch(): many seeds per call, structure-of-arrays	  *
+*	17/Oct/26    Batch kernel hook (SIMD lanes) and seedOrder()				  *
+*	17/Oct/26    Makespan cache keyed by a Zobrist hash of the seed			  *
+*	17/Oct/26    analyzeSeed(): CSR disjunctive graph and critical path		  *
+*	17/Oct/26    seedPositions()/seedSwap(): O(1) position of a job in a seed  *
+*	17/Oct/26    insertEstimate(): head/tail estimate of an insertion move     *
 ******************************************************************************/
 
 #ifdef __cplusplus
@@ -23,40 +34,30 @@ int factivel(int *vPriorities, int *vSequences, int iPrioMode, int *iTEMPO);
 
 //Defines
 
-#define PROGRAMA_01
-//#define PROGRAMA_06
-//#define PROGRAMA_11
-//#define PROGRAMA_16
-//#define PROGRAMA_21
-
-#ifdef PROGRAMA_01
-    #define MACHINE			5
-    #define JOB    			10
-#endif
-
-#ifdef PROGRAMA_06
-    #define MACHINE			5
-    #define JOB    			15
-#endif
-
-#ifdef PROGRAMA_11
-    #define MACHINE			5
-    #define JOB    			20
-#endif
-
-#ifdef PROGRAMA_16
-    #define MACHINE			10
-    #define JOB    			10
-#endif
+#define TIME_STEP   	1
+#define ITERMAX(iJobs)	(1000*(iJobs)*TIME_STEP)	/* unfeasible sentinel */
+#define MAXLANES		16		/* widest batch kernel (AVX-512, 16 x int32) */
+#define CACHEPEROP		512		/* cache entries per operation, cacheInit() */
+#define GRAPHEDGES(iMachines, iJobs) \
+		(2*(iMachines)*(iJobs) + (iJobs))	/* arcs of the disjunctive graph */
 
-#ifdef PROGRAMA_21
-    #define MACHINE			10
-    #define JOB    			15
-#endif
+/******************************************************************************
+* 	Struct: Instance														  *
+*	Short Description: Problem being solved. The dimensions are runtime 	  *
+*					   values, so one binary handles every LAxx size.		  *
+*	vRoutes -> machines (1-index) visited by each job - iJobs lines x		  *
+*			   iMachines rows (R in main)									  *
+*	vTimes  -> processing times, same layout (T in main)					  *
+*******************************************************************************/
 
-#define SEQUENCE	    JOB
-#define TIME_STEP   	1
-#define ITER            1000*JOB*TIME_STEP
+typedef struct instance {
+	int iProblem;						/* LAxx							  */
+	int iMachines;
+	int iJobs;
+	int iIter;							/* ITERMAX(iJobs)				  */
+	int *vRoutes;
+	int *vTimes;
+} Instance;
 
 /******************************************************************************
 * 	Function: int factivel(int *vPriorities, int *vSequences, int iPrioMode)  *
@@ -68,10 +69,334 @@ int factivel(int *vPriorities, int *vSequences, int iPrioMode, int *iTEMPO);
 *	iPrioMode   -> 0 - only executes the sequence, no priority				  *
 *				   1 - job x machine priority								  *
 *	Return:																	  *
-*   Time steps for processing. If returns 1000, the sequence x priority	 	  *
-*   is not valid.															  *
+*   Time steps for processing. If returns ITERMAX(JOB), the sequence x	  *
+*   priority is not valid. Dimensions come from selectInstance(), which must  *
+*   be called first. The evaluation context is kept between calls and only	  *
+*   rebuilt when vSequences, iTEMPO or iPrioMode change, so factivel() is	  *
+*   not reentrant; threads use their own EvalContext.						  *
 *******************************************************************************/
 
 int factivel(int *vPriorities, int *vSequences, int iPrioMode, int *iTEMPO);
 
+/******************************************************************************
+* 	Struct: EvalContext														  *
+*	Short Description: Scratch state of one evaluation. The instance data	  *
+*					   (routes and times) is only pointed to, never copied,	  *
+*					   so each thread can own a context and evaluate		  *
+*					   concurrently with the others.						  *
+*******************************************************************************/
+
+struct sequence {
+	int iStep;
+	int iWaiting;
+	int iWaitingFor;
+	int itempo;
+	int iFinish;
+	int iMach;
+	int isActive;
+	int isDead;
+	int iSequences;
+};
+
+typedef struct evalcontext {
+	const Instance *pInstance;
+	const int *vSequences;				/* routes - iJobs lines x iMachines rows */
+	const int *vTimes;					/* times  - iJobs lines x iMachines rows */
+	int iMachines;
+	int iJobs;
+	int iIter;
+	int iPrioMode;
+	int (*pfDecode)(struct evalcontext *ctx, const int *vSeed, int *vStart,
+					int iCutoff);
+
+	/* scratch, sized from the instance by evalInit() */
+	int *machines;
+	int *priomachines;
+	int *ordmachines;					/* iMachines x iJobs					  */
+	struct sequence *sSequence;
+
+	/* decodeSeed() - operation op = job*iMachines + step */
+	int *opmachine;						/* step of job j on machine m, -1 if none */
+										/* [j*iMachines + m]; op = j*M + step */
+	int *indegree;
+	int *mnext;							/* next operation on the same machine	  */
+	int *ready;
+	int *start;
+	int *tail;							/* work of the job from op to its end	  */
+	int *mtail;							/* work of the machine from op to its end */
+	int *order;							/* topological order, seedOrder()		  */
+	int *seed;							/* candidate copied out of a batch		  */
+	int *lanes;							/* batch kernel: 2*(M*J+1)*MAXLANES	  */
+
+	/* analyzeSeed() - disjunctive graph in CSR: node 0 is the source,	  */
+	/* op+1 the operations and M*J+1 the sink							  */
+	int *succptr;						/* M*J+3 offsets into succ			  */
+	int *succ;							/* GRAPHEDGES						  */
+	int *predptr;						/* M*J+3 offsets into pred			  */
+	int *pred;							/* GRAPHEDGES						  */
+	int *dist;							/* longest path from the source		  */
+	int *degree;
+	int *queue;							/* topological order of the nodes	  */
+
+	/* makespan cache, off until cacheInit() */
+	unsigned long long *zobrist;		/* key of job j at seed position i,	  */
+										/* [i*iJobs + j]					  */
+	unsigned long long *cache;			/* 2 words per entry: key^data, data  */
+	unsigned long iCacheMask;			/* entries - 1 (power of two)		  */
+	unsigned long iCacheHits;
+	unsigned long iCacheMisses;
+} EvalContext;
+
+/* Decoder for one instance shape (registerKernel()). Declared outside the
+   extern "C" block: the kernels are C++ template instantiations. */
+typedef int (*DecodeKernel)(EvalContext *ctx, const int *vSeed, int *vStart,
+							int iCutoff);
+
+/* Batch decoder (registerBatchKernel()), also C++ (Scheduling_simd.cpp) */
+typedef int (*BatchKernel)(EvalContext *ctx, const int *vSeeds, int iStride,
+						   int iCount, int iCutoff, int *vMakespans);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+* 	Function: void evalInit(EvalContext *ctx, const Instance *pInstance,	  *
+*							int iPrioMode)									  *
+*	Short Description: Binds a context to an instance and allocates its	  *
+*					   scratch. Release with evalFree().					  *
+*	Return:																	  *
+*   1, or 0 if the scratch could not be allocated (the context is then only  *
+*   good for evalFree()).													  *
+*******************************************************************************/
+
+int evalInit(EvalContext *ctx, const Instance *pInstance, int iPrioMode);
+void evalFree(EvalContext *ctx);
+
+/******************************************************************************
+* 	Function: void selectInstance(const Instance *pInstance)				  *
+*	Short Description: Instance whose dimensions factivel() uses.			  *
+*******************************************************************************/
+
+void selectInstance(const Instance *pInstance);
+
+/******************************************************************************
+* 	Function: void registerKernel(int iMachines, int iJobs, DecodeKernel pf)  *
+*	Short Description: Registers a decoder specialized for one instance		  *
+*					   shape. evalInit() picks it up for instances of that	  *
+*					   shape; the generic decoder is used for the others.	  *
+*******************************************************************************/
+
+void registerKernel(int iMachines, int iJobs, DecodeKernel pf);
+
+/******************************************************************************
+* 	Function: int evaluate(EvalContext *ctx, int *vPriorities)				  *
+*	Short Description: Same as factivel(), using only the state in ctx.	  *
+*******************************************************************************/
+
+int evaluate(EvalContext *ctx, int *vPriorities);
+
+/******************************************************************************
+* 	Function: int decodeSeed(EvalContext *ctx, const int *vSeed, int *vStart) *
+*	Short Description: Builds the semi-active schedule straight from a seed,  *
+*					   without the priority matrix round-trip.				  *
+*	Parameters:																  *
+*	vSeed  -> jobs (1-index) in processing order, machine by machine -		  *
+*			  iMachines blocks of iJobs elements (same layout as S in main)	  *
+*	vStart -> optional (may be NULL), receives the start time of each		  *
+*			  operation, indexed as job*iMachines + step					  *
+*	Return:																	  *
+*   Makespan, the same value factivel() returns for the priority matrix	  *
+*   built from vSeed. Returns iIter if the seed is not feasible (cycle among  *
+*   job and machine precedences, or a job repeated on a machine).			  *
+*   decodeSeed() dispatches to the kernel registered for the shape, if any;  *
+*   decodeSeedGeneric() is the runtime-sized fallback.						  *
+*******************************************************************************/
+
+int decodeSeed(EvalContext *ctx, const int *vSeed, int *vStart);
+
+/******************************************************************************
+* 	Function: int decodeSeedCutoff(EvalContext *ctx, const int *vSeed,		  *
+*								   int iCutoff)								  *
+*	Short Description: decodeSeed() for callers that only want to know if	  *
+*					   the seed beats iCutoff. The decoding stops as soon as  *
+*					   an operation's start plus the remaining work of its	  *
+*					   job or of its machine reaches iCutoff.				  *
+*	Return:																	  *
+*   The makespan, if it is smaller than iCutoff. Otherwise a value >=		  *
+*   iCutoff ("not better"), which may or may not be iIter for infeasible	  *
+*   seeds. With iCutoff = iIter it returns exactly what decodeSeed() does.	  *
+*******************************************************************************/
+
+int decodeSeedCutoff(EvalContext *ctx, const int *vSeed, int iCutoff);
+
+/******************************************************************************
+* 	Function: int evaluateBatch(EvalContext *ctx, const int *vSeeds,		  *
+*								int iStride, int iCount, int iCutoff,		  *
+*								int *vMakespans)							  *
+*	Short Description: decodeSeedCutoff() for iCount seeds in one call,	  *
+*					   reusing the context scratch for all of them.			  *
+*	Parameters:																  *
+*	vSeeds     -> the seeds as structure-of-arrays: element i (same layout	  *
+*				  as vSeed) of seed c is vSeeds[i*iStride + c], iStride >=	  *
+*				  iCount													  *
+*	iCutoff    -> as in decodeSeedCutoff(); iIter for exact makespans		  *
+*	vMakespans -> receives the iCount results								  *
+*	Return:																	  *
+*   How many seeds scored below iCutoff.									  *
+*******************************************************************************/
+
+int evaluateBatch(EvalContext *ctx, const int *vSeeds, int iStride, int iCount,
+				  int iCutoff, int *vMakespans);
+int evaluateBatchScalar(EvalContext *ctx, const int *vSeeds, int iStride,
+						int iCount, int iCutoff, int *vMakespans);
+
+/******************************************************************************
+* 	Function: void registerBatchKernel(BatchKernel pf)						  *
+*	Short Description: Replaces the seed-by-seed loop of evaluateBatch()	  *
+*					   (evaluateBatchScalar) by pf, e.g. a kernel that		  *
+*					   decodes several seeds at once in SIMD lanes. NULL	  *
+*					   goes back to the scalar loop.						  *
+*******************************************************************************/
+
+void registerBatchKernel(BatchKernel pf);
+int decodeSeedGeneric(EvalContext *ctx, const int *vSeed, int *vStart,
+					  int iCutoff);
+
+/******************************************************************************
+* 	Function: void cacheInit(EvalContext *ctx, int iEntries)				  *
+*	Short Description: Turns on the makespan cache of the context, with		  *
+*					   iEntries slots rounded up to a power of two (0 sizes	  *
+*					   it from the instance: CACHEPEROP per operation).		  *
+*					   decodeSeed() without vStart, decodeSeedCutoff() and	  *
+*					   evaluateBatch() then look the seed up by its Zobrist	  *
+*					   hash before decoding it, and store what they decode.	  *
+*					   An entry holds the exact makespan, or only a lower	  *
+*					   bound when the decoding stopped at a cutoff; a bound	  *
+*					   answers the lookups whose cutoff it already reaches.	  *
+*					   The table is direct-mapped and each slot is written	  *
+*					   as key^data and data, so a torn slot never matches and *
+*					   readers need no lock. Two seeds with the same 64-bit	  *
+*					   hash would share an entry; the odds are negligible.	  *
+*					   evalFree() releases it; evalInit() of another instance *
+*					   starts without cache. If the table cannot be			  *
+*					   allocated the context stays without cache.			  *
+*	cacheClear() empties the table and zeroes iCacheHits and iCacheMisses.	  *
+*	seedHash() is the key of a seed, 0 if the seed has a job out of range.	  *
+*******************************************************************************/
+
+void cacheInit(EvalContext *ctx, int iEntries);
+void cacheClear(EvalContext *ctx);
+unsigned long long seedHash(const EvalContext *ctx, const int *vSeed);
+
+/******************************************************************************
+* 	Function: void seedPositions(const EvalContext *ctx, const int *vSeed,	  *
+*								 int *vPos)									  *
+*	Short Description: Position index of a seed: vPos[m*iJobs + j] is the	  *
+*					   index in vSeed of job j (0-index) on machine m		  *
+*					   (0-index), so vSeed[vPos[m*iJobs + j]] == j+1. Jobs	  *
+*					   missing from a machine keep -1.						  *
+*	seedSwap() swaps vSeed[iA] and vSeed[iB] (same machine) and keeps vPos	  *
+*	up to date in O(1).														  *
+*******************************************************************************/
+
+void seedPositions(const EvalContext *ctx, const int *vSeed, int *vPos);
+void seedSwap(const EvalContext *ctx, int *vSeed, int *vPos, int iA, int iB);
+
+/******************************************************************************
+* 	Function: int seedFeasible(EvalContext *ctx, const int *vSeed)			  *
+*	Short Description: Cycle check on the disjunctive graph of the seed	  *
+*					   (job routes plus the machine orders of vSeed), in	  *
+*					   O(J*M) and without computing any time. Returns 1 if	  *
+*					   decodeSeed() would give a schedule, 0 if it would	  *
+*					   give iIter because of a cycle or an invalid seed.	  *
+*******************************************************************************/
+
+int seedFeasible(EvalContext *ctx, const int *vSeed);
+
+/******************************************************************************
+* 	Function: int seedOrder(EvalContext *ctx, const int *vSeed, int *vOrder) *
+*	Short Description: Topological order of the operations of the seed in	  *
+*					   vOrder. Returns how many operations were ordered:	  *
+*					   iMachines*iJobs if the seed is feasible, fewer if not. *
+*******************************************************************************/
+
+int seedOrder(EvalContext *ctx, const int *vSeed, int *vOrder);
+
+/******************************************************************************
+* 	Function: int decodeHeadsTails(EvalContext *ctx, const int *vSeed,		  *
+*								   int *vHead, int *vTail)					  *
+*	Short Description: decodeSeed() that also returns, for each operation	  *
+*					   op = job*iMachines + step, its head (start time) and	  *
+*					   its tail (longest path from its end to the end of the  *
+*					   schedule, without its own time). Makespan or iIter.	  *
+*					   Same as analyzeSeed() without the critical path.		  *
+*******************************************************************************/
+
+int decodeHeadsTails(EvalContext *ctx, const int *vSeed, int *vHead, int *vTail);
+
+/******************************************************************************
+* 	Function: int analyzeSeed(EvalContext *ctx, const int *vSeed, int *vHead, *
+*							  int *vTail, int *vPath, int *piPath)			  *
+*	Short Description: Builds the disjunctive graph of the seed once, in	  *
+*					   compressed sparse rows, and in one linear pass gets	  *
+*					   the makespan, the heads, the tails and the critical	  *
+*					   path (the CPM of projectDuration/findCriticalPath).	  *
+*	Parameters:																  *
+*	vHead, vTail -> optional, as in decodeHeadsTails(); the tails are only	  *
+*					filled for feasible seeds								  *
+*	vPath        -> optional, iMachines*iJobs+2 elements: the nodes (op+1)	  *
+*					of the critical path from the sink back to the source,	  *
+*					ending with 0; *piPath receives its length. Ties go to	  *
+*					the predecessor with the latest head, job arc first.	  *
+*	Return:																	  *
+*   Makespan, or iIter if the seed is not feasible. With a cycle the heads	  *
+*   and the path come from the part of the graph reached before it.		  *
+*******************************************************************************/
+
+int analyzeSeed(EvalContext *ctx, const int *vSeed, int *vHead, int *vTail,
+				int *vPath, int *piPath);
+
+/******************************************************************************
+* 	Function: int swapEstimate(EvalContext *ctx, const int *vSeed,			  *
+*							   const int *vHead, const int *vTail,			  *
+*							   int iMachine, int iPos)						  *
+*	Short Description: Taillard's estimate of the makespan after swapping	  *
+*					   the jobs at positions iPos and iPos+1 of machine		  *
+*					   iMachine (0-index), in O(1), from the heads and tails  *
+*					   of vSeed. If the swap is feasible, the estimate is the *
+*					   longest path through the swapped pair, so it never	  *
+*					   exceeds the new makespan: a move whose estimate does	  *
+*					   not beat the incumbent can be skipped.				  *
+*******************************************************************************/
+
+int swapEstimate(EvalContext *ctx, const int *vSeed, const int *vHead,
+				 const int *vTail, int iMachine, int iPos);
+
+/******************************************************************************
+* 	Function: int insertEstimate(EvalContext *ctx, const int *vSeed,		  *
+*								 const int *vHead, const int *vTail,		  *
+*								 int iMachine, int iFrom, int iTo)			  *
+*	Short Description: Estimate of the makespan after moving the job at	  *
+*					   position iFrom of machine iMachine (0-index) to		  *
+*					   position iTo, the jobs in between shifting by one, in  *
+*					   O(|iTo-iFrom|) from the heads and tails of vSeed: the  *
+*					   new heads and tails of the shifted segment, with the	  *
+*					   job neighbours kept as they are, and the longest path  *
+*					   through it. Only an approximation (the job neighbours  *
+*					   may move too); iTo = iFrom+1 is swapEstimate().		  *
+*	Return:																	  *
+*   The estimate, or iIter when the move may close a cycle: moving forward,	  *
+*   if the head of the job at iTo reaches the end of the job successor of	  *
+*   the moved operation; moving backward, the same with tails and the job	  *
+*   predecessor. Below that no path can join them and the move is feasible.  *
+*******************************************************************************/
+
+int insertEstimate(EvalContext *ctx, const int *vSeed, const int *vHead,
+				   const int *vTail, int iMachine, int iFrom, int iTo);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _FACT_ */
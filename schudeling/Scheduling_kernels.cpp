@@ -0,0 +1,109 @@
+/******************************************************************************
+* 	Scheduling_kernels.cpp													  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+*																			  *
+*	Short Description: decodeSeed() specialized for the instance shapes in	  *
+*					   use. evalInit() selects them through registerKernel(); *
+*					   other shapes keep using decodeSeedGeneric().			  *
+******************************************************************************/
+
+#include "Scheduling_kernels.h"
+
+template<int M, int J>
+int decodeSeedFixed(EvalContext *ctx, const int *vSeed, int *vStart,
+					int iCutoff){
+
+	int indegree[M*J];
+	int mnext[M*J];
+	int ready[M*J];
+	int local[M*J];
+	int mtail[M*J];
+	int *start = vStart ? vStart : local;
+	const int *opmachine = ctx->opmachine;
+	const int *tail = ctx->tail;
+	const int *vTimes = ctx->vTimes;
+	int iTop = 0, iDone = 0, iMakespan = 0;
+
+	// Arestas de job: toda operação, menos a primeira de cada job, depende
+	// da anterior. mnext == -2 marca operação ainda não vista na semente.
+	for(int op=0;op<M*J;op++){
+		indegree[op] = (op%M) ? 1 : 0;
+		mnext[op] = -2;
+		start[op] = 0;
+	}
+
+	// Arestas de máquina, na ordem dada pela semente
+	for(int m=0;m<M;m++){
+		int prev = -1;
+
+		for(int k=0;k<J;k++){
+			int job = vSeed[m*J+k]-1;
+			if(job<0 || job>=J || opmachine[job*M+m]<0) return ctx->iIter;
+
+			int op = job*M + opmachine[job*M+m];
+			if(mnext[op]!=-2) return ctx->iIter;
+
+			mnext[op] = -1;
+			if(prev>=0){
+				mnext[prev] = op;
+				indegree[op]++;
+			}
+			prev = op;
+		}
+	}
+
+	// Trabalho restante da máquina a partir de cada operação (inclusive)
+	for(int m=0;m<M;m++){
+		int rest = 0;
+
+		for(int k=J-1;k>=0;k--){
+			int job = vSeed[m*J+k]-1;
+			int op = job*M + opmachine[job*M+m];
+			rest += vTimes[op];
+			mtail[op] = rest;
+		}
+	}
+
+	for(int op=0;op<M*J;op++)
+		if(indegree[op]==0) ready[iTop++] = op;
+
+	// Ordem topológica: cada operação começa quando o job e a máquina liberam
+	while(iTop>0){
+		int op = ready[--iTop];
+		int fin = start[op] + vTimes[op];
+		iDone++;
+
+		// O início já é definitivo: nenhum término pode ficar abaixo disto
+		if(start[op]+tail[op]>=iCutoff || start[op]+mtail[op]>=iCutoff)
+			return iCutoff;
+
+		if(fin>iMakespan) iMakespan = fin;
+
+		if((op+1)%M){
+			if(fin>start[op+1]) start[op+1] = fin;
+			if(--indegree[op+1]==0) ready[iTop++] = op+1;
+		}
+
+		int next = mnext[op];
+		if(next>=0){
+			if(fin>start[next]) start[next] = fin;
+			if(--indegree[next]==0) ready[iTop++] = next;
+		}
+	}
+
+	if(iDone<M*J) return ctx->iIter;
+	if(iMakespan>=iCutoff) return iCutoff;
+
+	return iMakespan;
+}
+
+void registerFixedKernels(){
+
+	registerKernel( 5, 10, decodeSeedFixed< 5, 10>); // LA01 a LA05
+	registerKernel( 5, 15, decodeSeedFixed< 5, 15>); // LA06 a LA10
+	registerKernel( 5, 20, decodeSeedFixed< 5, 20>); // LA11 a LA15
+	registerKernel(10, 10, decodeSeedFixed<10, 10>); // LA16 a LA20
+	registerKernel(10, 15, decodeSeedFixed<10, 15>); // LA21 a LA25
+}
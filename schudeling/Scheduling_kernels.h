@@ -0,0 +1,35 @@
+/******************************************************************************
+* 	Scheduling_kernels.h													  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+******************************************************************************/
+
+#ifndef _KERNELS_
+
+#define _KERNELS_
+
+#include "Scheduling_fact.h"
+
+/******************************************************************************
+* 	Function: void registerFixedKernels()									  *
+*	Short Description: Registers, through registerKernel(), the decoders	  *
+*					   compiled for the LAxx shapes (5x10, 5x15, 5x20,		  *
+*					   10x10 and 10x15). Call it once, before evalInit().	  *
+*******************************************************************************/
+
+void registerFixedKernels();
+
+/******************************************************************************
+* 	Function: int decodeSeedFixed<M, J>(EvalContext *ctx, const int *vSeed,  *
+*										int *vStart, int iCutoff)			  *
+*	Short Description: decodeSeedGeneric() with the dimensions known at		  *
+*					   compile time: the loops have constant bounds and the	  *
+*					   scratch lives on the stack. Same return values.		  *
+*******************************************************************************/
+
+template<int M, int J>
+int decodeSeedFixed(EvalContext *ctx, const int *vSeed, int *vStart,
+					int iCutoff);
+
+#endif /* _KERNELS_ */
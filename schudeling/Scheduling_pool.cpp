@@ -0,0 +1,165 @@
+/******************************************************************************
+* 	Scheduling_pool.cpp														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+*																			  *
+*	Short Description: Persistent work-stealing thread pool (poolRun()).	  *
+******************************************************************************/
+
+#include "Scheduling_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fila de tarefas de cada thread: a dona tira do fim, as outras roubam do
+// início (os blocos ficam contíguos para a dona enquanto não há roubo)
+struct PoolQueue {
+	std::mutex mtx;
+	std::deque<int> tasks;
+};
+
+static std::vector<std::thread> vThreads;
+static PoolQueue *vQueues = NULL;
+static int iWorkers = 0;
+
+static std::mutex mtxPool;
+static std::condition_variable cvStart, cvDone;
+static unsigned long iRound = 0;			// rodada de poolRun() em curso
+static bool bStop = false;
+static std::atomic<int> iPending(0);		// tarefas da rodada ainda não concluídas
+
+static PoolTask pfTask = NULL;
+static void *pTaskData = NULL;
+
+// Próxima tarefa para a thread w: da própria fila ou roubada de outra
+static int nexttask(int w){
+
+	int i, v, iTask = -1;
+
+	{
+		std::lock_guard<std::mutex> lock(vQueues[w].mtx);
+		if(!vQueues[w].tasks.empty()){
+			iTask = vQueues[w].tasks.back();
+			vQueues[w].tasks.pop_back();
+			return iTask;
+		}
+	}
+
+	for(i=1;i<iWorkers;i++){
+		v = (w+i) % iWorkers;
+		std::lock_guard<std::mutex> lock(vQueues[v].mtx);
+		if(!vQueues[v].tasks.empty()){
+			iTask = vQueues[v].tasks.front();
+			vQueues[v].tasks.pop_front();
+			return iTask;
+		}
+	}
+
+	return -1;
+}
+
+static void workerloop(int w){
+
+	unsigned long iSeen = 0;
+	int iTask;
+
+	for(;;){
+		{
+			std::unique_lock<std::mutex> lock(mtxPool);
+			cvStart.wait(lock, [&]{ return bStop || iRound!=iSeen; });
+			if(bStop) return;
+			iSeen = iRound;
+		}
+
+		while((iTask = nexttask(w))>=0){
+			pfTask(iTask, w, pTaskData);
+
+			if(--iPending==0){
+				std::lock_guard<std::mutex> lock(mtxPool);
+				cvDone.notify_all();
+			}
+		}
+	}
+}
+
+int poolStart(int iCount){
+
+	int w;
+
+	poolStop();
+
+	if(iCount<=0) iCount = std::thread::hardware_concurrency();
+	if(iCount<=0) iCount = 1;
+
+	vQueues = new PoolQueue[iCount];
+	iWorkers = iCount;
+	bStop = false;
+
+	for(w=0;w<iCount;w++)
+		vThreads.push_back(std::thread(workerloop, w));
+
+	return iWorkers;
+}
+
+void poolStop(){
+
+	size_t i;
+
+	if(iWorkers==0) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		bStop = true;
+	}
+	cvStart.notify_all();
+
+	for(i=0;i<vThreads.size();i++)
+		vThreads[i].join();
+
+	vThreads.clear();
+	delete [] vQueues;
+	vQueues = NULL;
+	iWorkers = 0;
+}
+
+int poolWorkers(){
+
+	return iWorkers;
+}
+
+void poolRun(int iTasks, PoolTask pf, void *pData){
+
+	int i, w;
+
+	if(iTasks<=0) return;
+
+	if(iWorkers==0){
+		for(i=0;i<iTasks;i++)
+			pf(i, 0, pData);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mtxPool);
+
+	pfTask = pf;
+	pTaskData = pData;
+	iPending = iTasks;
+
+	// Blocos contíguos; a dona tira do fim, então empilha de trás para frente
+	// para começar pela primeira tarefa do bloco
+	for(w=0;w<iWorkers;w++){
+		std::lock_guard<std::mutex> lockq(vQueues[w].mtx);
+		for(i=(int) ((long) iTasks*(w+1)/iWorkers)-1;i>=(int) ((long) iTasks*w/iWorkers);i--)
+			vQueues[w].tasks.push_back(i);
+	}
+
+	iRound++;
+	cvStart.notify_all();
+
+	cvDone.wait(lock, []{ return iPending.load()==0; });
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+* 	Scheduling_pool.h														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+******************************************************************************/
+
+#ifndef _POOL_
+
+#define _POOL_
+
+/******************************************************************************
+* 	Type: PoolTask															  *
+*	Short Description: Task run by the pool: iTask is the index of the task	  *
+*					   (0..iTasks-1), iWorker the index of the worker thread  *
+*					   that runs it (0..poolWorkers()-1) and pData the		  *
+*					   pointer given to poolRun().							  *
+*******************************************************************************/
+
+typedef void (*PoolTask)(int iTask, int iWorker, void *pData);
+
+/******************************************************************************
+* 	Function: int poolStart(int iWorkers)									  *
+*	Short Description: Starts the persistent pool with iWorkers threads		  *
+*					   (0 = one per hardware thread). The threads live until  *
+*					   poolStop(), so thread_local state of the tasks (e.g.	  *
+*					   evaluation contexts) survives between poolRun() calls. *
+*					   Returns the number of workers.						  *
+*******************************************************************************/
+
+int poolStart(int iWorkers);
+
+/******************************************************************************
+* 	Function: void poolStop()												  *
+*	Short Description: Stops and joins the worker threads.					  *
+*******************************************************************************/
+
+void poolStop();
+
+/******************************************************************************
+* 	Function: int poolWorkers()												  *
+*	Short Description: Number of worker threads (0 if the pool is stopped).	  *
+*******************************************************************************/
+
+int poolWorkers();
+
+/******************************************************************************
+* 	Function: void poolRun(int iTasks, PoolTask pf, void *pData)			  *
+*	Short Description: Runs pf for the tasks 0..iTasks-1 on the workers and	  *
+*					   returns when all of them are done. Each worker starts  *
+*					   with a contiguous block of tasks and, when it runs	  *
+*					   out, steals from the other end of the other workers'	  *
+*					   queues. The calling thread only waits; with the pool	  *
+*					   stopped the tasks run on it, in order (worker 0).	  *
+*******************************************************************************/
+
+void poolRun(int iTasks, PoolTask pf, void *pData);
+
+#endif /* _POOL_ */
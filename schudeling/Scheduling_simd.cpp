@@ -0,0 +1,295 @@
+/******************************************************************************
+* 	Scheduling_simd.cpp														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+*																			  *
+*	Short Description: Lane-parallel evaluateBatch() (one seed per SIMD	  *
+*					   lane) for AVX2 and AVX-512, chosen at run time.		  *
+******************************************************************************/
+
+#include "Scheduling_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _SIMD_X86_
+#include <immintrin.h>
+#endif
+
+#define MAXPASSES		8		/* passes before a lane goes to the scalar decoder */
+#define MAXFALLBACK		4		/* 1/MAXFALLBACK of the lanes going scalar ends SIMD */
+
+#ifdef _SIMD_X86_
+
+// Ordem comum a todas as pistas: a ordem topológica da primeira semente do
+// lote (as demais costumam ser vizinhas dela). Se ela não for factível, usa
+// a ordem por passo, que também converge, só que em mais passadas.
+static void batchOrder(EvalContext *ctx, const int *vSeeds, int iStride){
+
+	int i, j, s;
+	int M = ctx->iMachines, J = ctx->iJobs;
+
+	for(i=0;i<M*J;i++)
+		ctx->seed[i] = vSeeds[i*iStride];
+
+	if(seedOrder(ctx, ctx->seed, ctx->order)==M*J) return;
+
+	i = 0;
+	for(s=0;s<M;s++)
+		for(j=0;j<J;j++)
+			ctx->order[i++] = j*M + s;
+}
+
+// Monta as iLanes pistas a partir da candidata c0: fin zerado (a linha M*J
+// é o zero das operações sem antecessora na máquina) e, em mpred, o índice
+// em fin da antecessora na máquina de cada operação, pista a pista.
+// vValid[l] = 0 se a semente da pista não é uma permutação dos jobs.
+static void batchLanes(EvalContext *ctx, const int *vSeeds, int iStride,
+					   int iCount, int c0, int iLanes, int *fin, int *mpred,
+					   int *vValid){
+
+	int l, c, m, k, op, prev, job;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int *seen = ctx->mnext;
+
+	for(op=0;op<(M*J+1)*iLanes;op++)
+		fin[op] = 0;
+
+	for(l=0;l<iLanes;l++){
+		c = (c0+l<iCount) ? c0+l : c0;		// pistas de sobra repetem c0
+		vValid[l] = 1;
+
+		for(op=0;op<M*J;op++)
+			seen[op] = 0;
+
+		for(m=0;m<M && vValid[l];m++){
+			prev = -1;
+			for(k=0;k<J;k++){
+				job = vSeeds[(m*J+k)*iStride+c]-1;
+				if(job<0 || job>=J || ctx->opmachine[job*M+m]<0){
+					vValid[l] = 0;
+					break;
+				}
+
+				op = job*M + ctx->opmachine[job*M+m];
+				if(seen[op]){
+					vValid[l] = 0;
+					break;
+				}
+				seen[op] = 1;
+
+				mpred[op*iLanes+l] = (prev>=0 ? prev : M*J)*iLanes + l;
+				prev = op;
+			}
+		}
+
+		if(!vValid[l])
+			for(op=0;op<M*J;op++)
+				mpred[op*iLanes+l] = M*J*iLanes + l;
+	}
+}
+
+// Resultado de uma pista: vBound é o limite inferior do makespan da última
+// passada (o próprio makespan se a pista convergiu)
+static int batchResult(EvalContext *ctx, const int *vSeeds, int iStride,
+					   int c, int iValid, int iBound, int iSettled,
+					   int iCutoff){
+
+	int i;
+
+	if(!iValid) return ctx->iIter;
+	if(iBound>=iCutoff) return iCutoff;
+	if(iSettled) return iBound;
+
+	// Não convergiu em MAXPASSES passadas: decodificação escalar
+	for(i=0;i<ctx->iMachines*ctx->iJobs;i++)
+		ctx->seed[i] = vSeeds[i*iStride+c];
+
+	if(ctx->pfDecode) return ctx->pfDecode(ctx, ctx->seed, NULL, iCutoff);
+
+	return decodeSeedGeneric(ctx, ctx->seed, NULL, iCutoff);
+}
+
+__attribute__((target("avx2")))
+int evaluateBatchAvx2(EvalContext *ctx, const int *vSeeds, int iStride,
+					  int iCount, int iCutoff, int *vMakespans){
+
+	const int L = 8;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int *fin = ctx->lanes;
+	int *mpred = ctx->lanes + (M*J+1)*L;
+	const int *vTimes = ctx->vTimes;
+	const int *tail = ctx->tail;
+	int vValid[L], vBound[L], vBusy[L];
+	int c0, l, i, op, pass, iFallback, iBetter = 0;
+
+	if(iCount<L/2) return evaluateBatchScalar(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+	if(iCutoff>ctx->iIter) iCutoff = ctx->iIter;
+
+	batchOrder(ctx, vSeeds, iStride);
+
+	for(c0=0;c0<iCount;c0+=L){
+		// Sobra com menos de meia pista cheia: escalar
+		if(iCount-c0<L/2)
+			return iBetter + evaluateBatchScalar(ctx, vSeeds+c0, iStride, iCount-c0, iCutoff, vMakespans+c0);
+
+		batchLanes(ctx, vSeeds, iStride, iCount, c0, L, fin, mpred, vValid);
+
+		const __m256i vZero = _mm256_setzero_si256();
+		const __m256i vCut = _mm256_set1_epi32(iCutoff);
+		__m256i vActive = _mm256_set1_epi32(-1);
+		__m256i vChanged, vLower;
+
+		// Relaxação em passadas: fin só cresce e nunca passa do término real,
+		// então fin + trabalho restante do job é um limite inferior do makespan
+		for(pass=0;;pass++){
+			vChanged = vZero;
+			vLower = vZero;
+
+			for(i=0;i<M*J;i++){
+				op = ctx->order[i];
+
+				__m256i vJob = (op%M) ? _mm256_loadu_si256((const __m256i *) (fin+(op-1)*L)) : vZero;
+				__m256i vIdx = _mm256_loadu_si256((const __m256i *) (mpred+op*L));
+				__m256i vMach = _mm256_i32gather_epi32(fin, vIdx, 4);
+				__m256i vFin = _mm256_add_epi32(_mm256_max_epi32(vJob, vMach), _mm256_set1_epi32(vTimes[op]));
+				__m256i vOld = _mm256_loadu_si256((const __m256i *) (fin+op*L));
+
+				vChanged = _mm256_or_si256(vChanged, _mm256_cmpgt_epi32(vFin, vOld));
+				_mm256_storeu_si256((__m256i *) (fin+op*L), vFin);
+				vLower = _mm256_max_epi32(vLower, _mm256_add_epi32(vFin, _mm256_set1_epi32(tail[op]-vTimes[op])));
+			}
+
+			// Pistas que já alcançaram o corte não melhoram: saem do laço
+			vActive = _mm256_andnot_si256(_mm256_cmpgt_epi32(vLower, _mm256_sub_epi32(vCut, _mm256_set1_epi32(1))), vActive);
+			vChanged = _mm256_and_si256(vChanged, vActive);
+
+			if(_mm256_testz_si256(vChanged, vChanged) || pass+1>=MAXPASSES) break;
+		}
+
+		_mm256_storeu_si256((__m256i *) vBound, vLower);
+		_mm256_storeu_si256((__m256i *) vBusy, vChanged);
+
+		iFallback = 0;
+		for(l=0;l<L && c0+l<iCount;l++){
+			if(vValid[l] && vBound[l]<iCutoff && vBusy[l]) iFallback++;
+			vMakespans[c0+l] = batchResult(ctx, vSeeds, iStride, c0+l, vValid[l], vBound[l], !vBusy[l], iCutoff);
+			if(vMakespans[c0+l]<iCutoff) iBetter++;
+		}
+
+		// Lote que não converge nas passadas (movimentos longos sem corte):
+		// o resto vai direto para o escalar
+		if(iFallback*MAXFALLBACK>L && c0+L<iCount)
+			return iBetter + evaluateBatchScalar(ctx, vSeeds+c0+L, iStride, iCount-c0-L, iCutoff, vMakespans+c0+L);
+	}
+
+	return iBetter;
+}
+
+__attribute__((target("avx512f")))
+int evaluateBatchAvx512(EvalContext *ctx, const int *vSeeds, int iStride,
+						int iCount, int iCutoff, int *vMakespans){
+
+	const int L = 16;
+	int M = ctx->iMachines, J = ctx->iJobs;
+	int *fin = ctx->lanes;
+	int *mpred = ctx->lanes + (M*J+1)*L;
+	const int *vTimes = ctx->vTimes;
+	const int *tail = ctx->tail;
+	int vValid[L], vBound[L];
+	int c0, l, i, op, pass, iFallback, iBetter = 0;
+
+	if(iCount<L) return evaluateBatchAvx2(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+	if(iCutoff>ctx->iIter) iCutoff = ctx->iIter;
+
+	batchOrder(ctx, vSeeds, iStride);
+
+	for(c0=0;c0<iCount;c0+=L){
+		// Pistas de 512 bits só cheias; a sobra vai para a versão AVX2
+		if(iCount-c0<L)
+			return iBetter + evaluateBatchAvx2(ctx, vSeeds+c0, iStride, iCount-c0, iCutoff, vMakespans+c0);
+
+		batchLanes(ctx, vSeeds, iStride, iCount, c0, L, fin, mpred, vValid);
+
+		const __m512i vZero = _mm512_setzero_si512();
+		const __m512i vCut = _mm512_set1_epi32(iCutoff);
+		__mmask16 kActive = 0xFFFF, kChanged;
+		__m512i vLower;
+
+		// Mesma relaxação da versão AVX2, com 16 pistas
+		for(pass=0;;pass++){
+			kChanged = 0;
+			vLower = vZero;
+
+			for(i=0;i<M*J;i++){
+				op = ctx->order[i];
+
+				__m512i vJob = (op%M) ? _mm512_loadu_si512((const void *) (fin+(op-1)*L)) : vZero;
+				__m512i vIdx = _mm512_loadu_si512((const void *) (mpred+op*L));
+				__m512i vMach = _mm512_i32gather_epi32(vIdx, (const void *) fin, 4);
+				__m512i vFin = _mm512_add_epi32(_mm512_max_epi32(vJob, vMach), _mm512_set1_epi32(vTimes[op]));
+				__m512i vOld = _mm512_loadu_si512((const void *) (fin+op*L));
+
+				kChanged |= _mm512_cmpgt_epi32_mask(vFin, vOld);
+				_mm512_storeu_si512((void *) (fin+op*L), vFin);
+				vLower = _mm512_max_epi32(vLower, _mm512_add_epi32(vFin, _mm512_set1_epi32(tail[op]-vTimes[op])));
+			}
+
+			kActive &= _mm512_cmplt_epi32_mask(vLower, vCut);
+			kChanged &= kActive;
+
+			if(!kChanged || pass+1>=MAXPASSES) break;
+		}
+
+		_mm512_storeu_si512((void *) vBound, vLower);
+
+		iFallback = 0;
+		for(l=0;l<L && c0+l<iCount;l++){
+			if(vValid[l] && vBound[l]<iCutoff && ((kChanged>>l)&1)) iFallback++;
+			vMakespans[c0+l] = batchResult(ctx, vSeeds, iStride, c0+l, vValid[l], vBound[l], !((kChanged>>l)&1), iCutoff);
+			if(vMakespans[c0+l]<iCutoff) iBetter++;
+		}
+
+		if(iFallback*MAXFALLBACK>L && c0+L<iCount)
+			return iBetter + evaluateBatchScalar(ctx, vSeeds+c0+L, iStride, iCount-c0-L, iCutoff, vMakespans+c0+L);
+	}
+
+	return iBetter;
+}
+
+int registerSimdKernels(){
+
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx512f")){
+		registerBatchKernel(evaluateBatchAvx512);
+		return 16;
+	}
+
+	if(__builtin_cpu_supports("avx2")){
+		registerBatchKernel(evaluateBatchAvx2);
+		return 8;
+	}
+
+	return 1;
+}
+
+#else /* _SIMD_X86_ */
+
+int evaluateBatchAvx2(EvalContext *ctx, const int *vSeeds, int iStride,
+					  int iCount, int iCutoff, int *vMakespans){
+
+	return evaluateBatchScalar(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+}
+
+int evaluateBatchAvx512(EvalContext *ctx, const int *vSeeds, int iStride,
+						int iCount, int iCutoff, int *vMakespans){
+
+	return evaluateBatchScalar(ctx, vSeeds, iStride, iCount, iCutoff, vMakespans);
+}
+
+int registerSimdKernels(){
+
+	return 1;
+}
+
+#endif /* _SIMD_X86_ */
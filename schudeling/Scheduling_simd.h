@@ -0,0 +1,48 @@
+/******************************************************************************
+* 	Scheduling_simd.h														  *
+*	Date: 17/Oct/2026												  		  *
+*	Revisions: 																  *
+*	17/Oct/26    First release												  *
+******************************************************************************/
+
+#ifndef _SIMD_
+
+#define _SIMD_
+
+#include "Scheduling_fact.h"
+
+/******************************************************************************
+* 	Function: int registerSimdKernels()										  *
+*	Short Description: Detects the CPU at run time and registers, through	  *
+*					   registerBatchKernel(), the widest lane-parallel batch  *
+*					   decoder it supports: 16 lanes with AVX-512, 8 lanes	  *
+*					   with AVX2. Otherwise evaluateBatch() keeps the scalar  *
+*					   loop. Returns the number of lanes (1 = scalar).		  *
+*******************************************************************************/
+
+int registerSimdKernels();
+
+/******************************************************************************
+* 	Function: int evaluateBatchAvx2(...), int evaluateBatchAvx512(...)		  *
+*	Short Description: evaluateBatch() decoding 8 (AVX2) or 16 (AVX-512)	  *
+*					   seeds in lockstep, one seed per lane. The start times  *
+*					   are relaxed in passes over a common topological order  *
+*					   (vector max/add, machine predecessors gathered per	  *
+*					   lane) until no lane changes; lanes that do not settle  *
+*					   in a few passes (e.g. cycles) go to the scalar decoder.*
+*					   Lanes are only used well filled: the AVX-512 version	  *
+*					   hands a tail of less than 16 seeds to the AVX2 one,	  *
+*					   and the AVX2 one a tail of less than 4 to the scalar	  *
+*					   loop. When more than 1/MAXFALLBACK of the lanes of a	  *
+*					   group do not settle (long moves scored without		  *
+*					   cutoff), the rest of the batch goes to the scalar	  *
+*					   loop, which is faster for such batches.				  *
+*					   Only call them on a CPU with the instruction set.	  *
+*******************************************************************************/
+
+int evaluateBatchAvx2(EvalContext *ctx, const int *vSeeds, int iStride,
+					  int iCount, int iCutoff, int *vMakespans);
+int evaluateBatchAvx512(EvalContext *ctx, const int *vSeeds, int iStride,
+						int iCount, int iCutoff, int *vMakespans);
+
+#endif /* _SIMD_ */